@@ -0,0 +1,159 @@
+/*
+ * Binary search tree benchmark: plain vs balanced trees under several insertion orders
+ *
+ * Build from the Containers directory:
+ *   gcc -O2 -I. benchmark/binary_search_tree_benchmark.c binary_search_tree.c -o bst_bench
+ * Usage:
+ *   ./bst_bench [number of keys]
+ */
+#include "binary_search_tree.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Sorted insertion degenerates a plain tree into a list, so keep the default size moderate
+#define DEFAULT_KEY_COUNT 20000
+
+/**
+ * @brief Perform integer comparison on keys
+ * @param k1 First key
+ * @param ks1 First key's length
+ * @param k2 Second key
+ * @param ks2 Second key's length
+ * @return 0 if keys are equal, >0 if k1 > k2, <0 if k2 > k1
+ */
+static int int_compare(void *k1, int ks1, void *k2, int ks2)
+{
+    int a = *(int *)k1;
+    int b = *(int *)k2;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Get a monotonic timestamp
+ * @return Seconds elapsed since an arbitrary point
+ */
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Get the height of a subtree by walking it
+ * @param node Root node of the subtree
+ * @return Height of the subtree
+ * @note Walks through parent links, so degenerate trees don't overflow the stack
+ */
+static int tree_height(bst_node_t *node)
+{
+    bst_node_t *stop, *previous, *next;
+    int depth = 0, height = 0;
+
+    stop = (node != NULL) ? node->parent : NULL;
+    previous = stop;
+    while (node != stop)
+    {
+        if (previous == node->parent)
+        {
+            // First visit, coming down from the parent
+            depth++;
+            if (depth > height)
+                height = depth;
+            next = (node->left != NULL) ? node->left : ((node->right != NULL) ? node->right : node->parent);
+        }
+        else if ((previous == node->left) && (node->right != NULL))
+        {
+            // Back from the left subtree, the right one is next
+            next = node->right;
+        }
+        else
+        {
+            // Both subtrees are done
+            next = node->parent;
+        }
+        if (next == node->parent)
+            depth--;
+        previous = node;
+        node = next;
+    }
+    return height;
+}
+
+/**
+ * @brief Insert and then look up every key of a given sequence
+ * @param name Name of the insertion order
+ * @param keys Keys in insertion order
+ * @param count Number of keys
+ * @param balanced Non-zero to use a balanced tree
+ */
+static void run(const char *name, int *keys, int count, int balanced)
+{
+    bst_tree_t *tree;
+    double start, insert_time, search_time;
+    int i;
+
+    tree = balanced ? bst_tree_new_balanced(int_compare) : bst_tree_new(int_compare);
+
+    start = now();
+    for (i = 0; i < count; i++)
+    {
+        bst_tree_insert(tree, tree->root, NULL, &keys[i], sizeof keys[i]);
+    }
+    insert_time = now() - start;
+
+    start = now();
+    for (i = 0; i < count; i++)
+    {
+        bst_tree_search(tree, tree->root, &keys[i], sizeof keys[i]);
+    }
+    search_time = now() - start;
+
+    printf("%10s %10s %8d %16.1f %16.1f\n", name, balanced ? "balanced" : "plain", tree_height(tree->root),
+           insert_time * 1e9 / count, search_time * 1e9 / count);
+    bst_tree_destroy(tree);
+}
+
+int main(int argc, char **argv)
+{
+    int count = DEFAULT_KEY_COUNT;
+    int *keys;
+    int i, j, temp;
+
+    if (argc > 1)
+        count = atoi(argv[1]);
+    keys = malloc(count * sizeof *keys);
+    if ((count <= 0) || (keys == NULL))
+        return 1;
+
+    printf("%10s %10s %8s %16s %16s\n", "order", "tree", "height", "insert (ns/op)", "search (ns/op)");
+
+    for (i = 0; i < count; i++)
+        keys[i] = i;
+    run("sorted", keys, count, 0);
+    run("sorted", keys, count, 1);
+
+    for (i = 0; i < count; i++)
+        keys[i] = count - i;
+    run("reverse", keys, count, 0);
+    run("reverse", keys, count, 1);
+
+    // Fisher-Yates shuffle of distinct keys
+    srand(1);
+    for (i = 0; i < count; i++)
+        keys[i] = i;
+    for (i = count - 1; i > 0; i--)
+    {
+        j = rand() % (i + 1);
+        temp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = temp;
+    }
+    run("random", keys, count, 0);
+    run("random", keys, count, 1);
+
+    free(keys);
+    return 0;
+}
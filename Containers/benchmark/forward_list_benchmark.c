@@ -0,0 +1,73 @@
+/*
+ * Forward list benchmark: bulk append through push_back and peek_back
+ *
+ * Build from the Containers directory:
+ *   gcc -O2 -I. benchmark/forward_list_benchmark.c forward_list.c -o forward_list_bench
+ * Usage:
+ *   ./forward_list_bench [largest number of items]
+ */
+#include "forward_list.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_ITEM_COUNT 1000000
+
+/**
+ * @brief Get a monotonic timestamp
+ * @return Seconds elapsed since an arbitrary point
+ */
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Append a number of items, peeking the back after every append
+ * @param count Number of items
+ */
+static void run(int count)
+{
+    forward_list_t *list;
+    double start, elapsed;
+    int i, back;
+
+    list = forward_list_new();
+    if (list == NULL)
+        exit(1);
+
+    start = now();
+    for (i = 0; i < count; i++)
+    {
+        forward_list_push_back(list, &i, sizeof i);
+        forward_list_peek_back(list, &back);
+    }
+    elapsed = now() - start;
+    if ((back != count - 1) || (forward_list_size(list) != (size_t)count))
+        exit(1);
+
+    // With O(1) appends the cost per item stays flat as the list grows
+    printf("%12d %14.3f %14.1f\n", count, elapsed * 1e3, elapsed * 1e9 / count);
+    forward_list_destroy(list);
+}
+
+int main(int argc, char **argv)
+{
+    int max_count = DEFAULT_ITEM_COUNT;
+    int count;
+
+    if (argc > 1)
+        max_count = atoi(argv[1]);
+    if (max_count <= 0)
+        return 1;
+
+    printf("%12s %14s %14s\n", "items", "total (ms)", "per item (ns)");
+    for (count = max_count / 16; count > 0 && count < max_count; count *= 2)
+        run(count);
+    run(max_count);
+
+    return 0;
+}
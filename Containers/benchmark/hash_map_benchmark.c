@@ -0,0 +1,147 @@
+/*
+ * Keyed lookup benchmark: hash map vs balanced binary search tree
+ *
+ * Build from the Containers directory:
+ *   gcc -O2 -I. benchmark/hash_map_benchmark.c hash_map.c binary_search_tree.c -o hash_bench
+ * Usage:
+ *   ./hash_bench [max number of keys]
+ */
+#include "hash_map.h"
+#include "binary_search_tree.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_MAX_KEYS 1000000
+
+/**
+ * @brief Perform integer comparison on keys
+ * @param k1 First key
+ * @param ks1 First key's length
+ * @param k2 Second key
+ * @param ks2 Second key's length
+ * @return 0 if keys are equal, >0 if k1 > k2, <0 if k2 > k1
+ */
+static int int_compare(void *k1, int ks1, void *k2, int ks2)
+{
+    int a = *(int *)k1;
+    int b = *(int *)k2;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Get a monotonic timestamp
+ * @return Seconds elapsed since an arbitrary point
+ */
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Insert keys into a hash map, then look up every key and as many missing ones
+ * @param keys Keys in insertion order, followed by as many keys that aren't inserted
+ * @param count Number of keys to insert
+ */
+static void run_hash_map(int *keys, int count)
+{
+    hash_map_t *map;
+    double start, insert_time, hit_time, miss_time;
+    int i;
+
+    map = hash_map_new(sizeof *keys, sizeof *keys, NULL);
+    if (map == NULL)
+        exit(1);
+
+    start = now();
+    for (i = 0; i < count; i++)
+        hash_map_insert(map, &keys[i], sizeof keys[i], &i);
+    insert_time = now() - start;
+
+    start = now();
+    for (i = 0; i < count; i++)
+        hash_map_find(map, &keys[i], sizeof keys[i]);
+    hit_time = now() - start;
+
+    start = now();
+    for (i = count; i < 2 * count; i++)
+        hash_map_find(map, &keys[i], sizeof keys[i]);
+    miss_time = now() - start;
+
+    printf("%10d %10s %16.1f %16.1f %16.1f\n", count, "hash map", insert_time * 1e9 / count, hit_time * 1e9 / count, miss_time * 1e9 / count);
+    hash_map_destroy(map);
+}
+
+/**
+ * @brief Insert keys into a balanced tree, then look up every key and as many missing ones
+ * @param keys Keys in insertion order, followed by as many keys that aren't inserted
+ * @param count Number of keys to insert
+ */
+static void run_tree(int *keys, int count)
+{
+    bst_tree_t *tree;
+    double start, insert_time, hit_time, miss_time;
+    int i;
+
+    tree = bst_tree_new_balanced(int_compare);
+    if (tree == NULL)
+        exit(1);
+
+    start = now();
+    for (i = 0; i < count; i++)
+        bst_tree_insert(tree, tree->root, NULL, &keys[i], sizeof keys[i]);
+    insert_time = now() - start;
+
+    start = now();
+    for (i = 0; i < count; i++)
+        bst_tree_search(tree, tree->root, &keys[i], sizeof keys[i]);
+    hit_time = now() - start;
+
+    start = now();
+    for (i = count; i < 2 * count; i++)
+        bst_tree_search(tree, tree->root, &keys[i], sizeof keys[i]);
+    miss_time = now() - start;
+
+    printf("%10d %10s %16.1f %16.1f %16.1f\n", count, "tree", insert_time * 1e9 / count, hit_time * 1e9 / count, miss_time * 1e9 / count);
+    bst_tree_destroy(tree);
+}
+
+int main(int argc, char **argv)
+{
+    int max_count = DEFAULT_MAX_KEYS;
+    int count;
+    int *keys;
+    int i, j, temp;
+
+    if (argc > 1)
+        max_count = atoi(argv[1]);
+    keys = malloc(2 * (size_t)max_count * sizeof *keys);
+    if ((max_count <= 0) || (keys == NULL))
+        return 1;
+
+    // Fisher-Yates shuffle of distinct keys
+    srand(1);
+    for (i = 0; i < 2 * max_count; i++)
+        keys[i] = i;
+    for (i = 2 * max_count - 1; i > 0; i--)
+    {
+        j = rand() % (i + 1);
+        temp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = temp;
+    }
+
+    printf("%10s %10s %16s %16s %16s\n", "keys", "container", "insert (ns/op)", "hit (ns/op)", "miss (ns/op)");
+    for (count = 1000; count <= max_count; count *= 10)
+    {
+        // Keys past the first count ones are distinct from them, so they are missing
+        run_hash_map(keys, count);
+        run_tree(keys, count);
+    }
+
+    free(keys);
+    return 0;
+}
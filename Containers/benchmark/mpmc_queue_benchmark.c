@@ -0,0 +1,178 @@
+/*
+ * MPMC queue benchmark: lock-free bounded queue vs a mutex-wrapped queue_t under contention
+ *
+ * Build from the Containers directory:
+ *   gcc -O2 -I. benchmark/mpmc_queue_benchmark.c mpmc_queue.c queue.c list.c node_pool.c -lpthread -o mpmc_bench
+ * Usage:
+ *   ./mpmc_bench [max producer/consumer pairs] [items per producer]
+ */
+#include "mpmc_queue.h"
+#include "queue.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_ITEM_COUNT 1000000
+#define QUEUE_CAPACITY 1024
+
+typedef struct locked_queue
+{
+    pthread_mutex_t lock;
+    queue_t *queue;
+} locked_queue_t;
+
+static mpmc_queue_t *mpmc;
+static locked_queue_t locked;
+static int items_per_thread;
+
+/**
+ * @brief Get a monotonic timestamp
+ * @return Seconds elapsed since an arbitrary point
+ */
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Producer thread for the lock-free queue
+ * @param arg Unused
+ * @return NULL
+ */
+static void *mpmc_producer(void *arg)
+{
+    int i;
+
+    for (i = 0; i < items_per_thread; i++)
+        mpmc_queue_push(mpmc, &i);
+    return NULL;
+}
+
+/**
+ * @brief Consumer thread for the lock-free queue
+ * @param arg Unused
+ * @return NULL
+ */
+static void *mpmc_consumer(void *arg)
+{
+    int i, value;
+
+    for (i = 0; i < items_per_thread; i++)
+        mpmc_queue_pop(mpmc, &value);
+    return NULL;
+}
+
+/**
+ * @brief Producer thread for the mutex-wrapped queue, bounded like the lock-free one
+ * @param arg Unused
+ * @return NULL
+ */
+static void *locked_producer(void *arg)
+{
+    int i, pushed;
+
+    for (i = 0; i < items_per_thread; i++)
+    {
+        do
+        {
+            pthread_mutex_lock(&locked.lock);
+            pushed = (queue_size(locked.queue) < QUEUE_CAPACITY) && (queue_push(locked.queue, &i, sizeof i) == 0);
+            pthread_mutex_unlock(&locked.lock);
+            if (!pushed)
+                sched_yield();
+        } while (!pushed);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Consumer thread for the mutex-wrapped queue
+ * @param arg Unused
+ * @return NULL
+ */
+static void *locked_consumer(void *arg)
+{
+    int i, value, popped;
+
+    for (i = 0; i < items_per_thread; i++)
+    {
+        do
+        {
+            pthread_mutex_lock(&locked.lock);
+            popped = !queue_empty(locked.queue);
+            if (popped)
+                queue_pop(locked.queue, &value);
+            pthread_mutex_unlock(&locked.lock);
+            if (!popped)
+                sched_yield();
+        } while (!popped);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Run a number of producer/consumer pairs to completion
+ * @param pairs Number of producers, and of consumers
+ * @param producer Producer start routine
+ * @param consumer Consumer start routine
+ * @return Transferred items per second
+ */
+static double run(int pairs, void *(*producer)(void *), void *(*consumer)(void *))
+{
+    pthread_t *threads;
+    double start;
+    int i;
+
+    threads = malloc(2 * pairs * sizeof *threads);
+    if (threads == NULL)
+        exit(1);
+
+    start = now();
+    for (i = 0; i < pairs; i++)
+    {
+        pthread_create(&threads[2 * i], NULL, producer, NULL);
+        pthread_create(&threads[2 * i + 1], NULL, consumer, NULL);
+    }
+    for (i = 0; i < 2 * pairs; i++)
+        pthread_join(threads[i], NULL);
+
+    free(threads);
+    return (double)pairs * items_per_thread / (now() - start);
+}
+
+int main(int argc, char **argv)
+{
+    int max_pairs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int pairs;
+
+    items_per_thread = DEFAULT_ITEM_COUNT;
+    if (argc > 1)
+        max_pairs = atoi(argv[1]);
+    if (argc > 2)
+        items_per_thread = atoi(argv[2]);
+    if ((max_pairs <= 0) || (items_per_thread <= 0))
+        return 1;
+
+    mpmc = mpmc_queue_new(sizeof(int), QUEUE_CAPACITY);
+    locked.queue = queue_new_fixed(sizeof(int), QUEUE_CAPACITY);
+    if ((mpmc == NULL) || (locked.queue == NULL) || (pthread_mutex_init(&locked.lock, NULL) != 0))
+        return 1;
+
+    printf("%8s %20s %20s\n", "pairs", "mpmc (Mitems/s)", "mutex (Mitems/s)");
+    for (pairs = 1; pairs <= max_pairs; pairs++)
+    {
+        printf("%8d %20.2f", pairs, run(pairs, mpmc_producer, mpmc_consumer) * 1e-6);
+        printf(" %20.2f\n", run(pairs, locked_producer, locked_consumer) * 1e-6);
+    }
+
+    pthread_mutex_destroy(&locked.lock);
+    queue_destroy(locked.queue);
+    mpmc_queue_destroy(mpmc);
+    return 0;
+}
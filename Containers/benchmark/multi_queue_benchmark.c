@@ -0,0 +1,266 @@
+/*
+ * Multi queue benchmark: relaxed concurrent priority queue vs a mutex-wrapped priority_queue_t
+ *
+ * Throughput runs the hold model: every thread repeatedly pops an item and pushes a new one with a
+ * later key, on a queue prefilled with items. Rank error is measured separately from a single thread
+ * on a queue with as many heaps as the throughput run uses: the rank of a popped item is the number
+ * of items in the queue that had priority over it, 0 for an exact priority queue.
+ *
+ * Build from the Containers directory:
+ *   gcc -O2 -I. benchmark/multi_queue_benchmark.c multi_queue.c priority_queue.c sorted_list.c heap.c minmax_heap.c pairing_heap.c radix_heap.c -lpthread -o mq_bench
+ * Usage:
+ *   ./mq_bench [max threads] [operations per thread] [heaps per thread]
+ */
+#include "multi_queue.h"
+#include "priority_queue.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_OPERATIONS 1000000
+#define DEFAULT_FACTOR 2
+#define PREFILL 100000
+// Keys are drawn below this bound, which is also the size of the rank counting tree
+#define KEY_SPACE (1 << 20)
+
+typedef struct locked_queue
+{
+    pthread_mutex_t lock;
+    priority_queue_t *queue;
+} locked_queue_t;
+
+static multi_queue_t *relaxed;
+static locked_queue_t locked;
+static int operations;
+
+/**
+ * @brief Perform integer comparison on data
+ * @param data1 First data
+ * @param data1_size First data's length
+ * @param data2 Second data
+ * @param data2_size Second data's length
+ * @return 0 if data are equal, >0 if data1 > data2, <0 if data2 > data1
+ */
+static int int_compare(void *data1, int data1_size, void *data2, int data2_size)
+{
+    int a = *(int *)data1;
+    int b = *(int *)data2;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Get a monotonic timestamp
+ * @return Seconds elapsed since an arbitrary point
+ */
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Draw the key of the item replacing a popped one
+ * @param key Key of the popped item
+ * @param seed Pointer to the calling thread's random state
+ * @return A key not smaller than the popped one
+ */
+static int next_key(int key, unsigned int *seed)
+{
+    key += rand_r(seed) % 1024;
+    return (key < KEY_SPACE) ? key : key % KEY_SPACE;
+}
+
+/**
+ * @brief Hold model thread for the multi queue
+ * @param arg Thread identifier
+ * @return NULL
+ */
+static void *relaxed_worker(void *arg)
+{
+    unsigned int seed = (unsigned int)(long)arg + 1;
+    int i, key;
+
+    for (i = 0; i < operations; i++)
+    {
+        if (multi_queue_pop(relaxed, &key) != 0)
+            key = 0;
+        key = next_key(key, &seed);
+        multi_queue_push(relaxed, &key, sizeof key);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Hold model thread for the mutex-wrapped priority queue
+ * @param arg Thread identifier
+ * @return NULL
+ */
+static void *locked_worker(void *arg)
+{
+    unsigned int seed = (unsigned int)(long)arg + 1;
+    int i, key;
+
+    for (i = 0; i < operations; i++)
+    {
+        pthread_mutex_lock(&locked.lock);
+        key = 0;
+        priority_queue_pop(locked.queue, &key);
+        pthread_mutex_unlock(&locked.lock);
+        key = next_key(key, &seed);
+        pthread_mutex_lock(&locked.lock);
+        priority_queue_push(locked.queue, &key, sizeof key);
+        pthread_mutex_unlock(&locked.lock);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Run a number of threads to completion
+ * @param count Number of threads
+ * @param worker Start routine
+ * @return Pop/push pairs per second
+ */
+static double run(int count, void *(*worker)(void *))
+{
+    pthread_t *threads;
+    double start;
+    int i;
+
+    threads = malloc(count * sizeof *threads);
+    if (threads == NULL)
+        exit(1);
+
+    start = now();
+    for (i = 0; i < count; i++)
+        pthread_create(&threads[i], NULL, worker, (void *)(long)i);
+    for (i = 0; i < count; i++)
+        pthread_join(threads[i], NULL);
+
+    free(threads);
+    return (double)count * operations / (now() - start);
+}
+
+/**
+ * @brief Add to the number of items with a given key in a Fenwick tree
+ * @param tree Pointer to the tree, KEY_SPACE + 1 counters
+ * @param key Key of the items
+ * @param delta Number of items to add
+ */
+static void tree_add(int *tree, int key, int delta)
+{
+    for (key++; key <= KEY_SPACE; key += key & -key)
+        tree[key] += delta;
+}
+
+/**
+ * @brief Count the items with a key smaller than a given one in a Fenwick tree
+ * @param tree Pointer to the tree, KEY_SPACE + 1 counters
+ * @param key Key bound
+ * @return Number of items
+ */
+static long tree_count_below(int *tree, int key)
+{
+    long count = 0;
+
+    for (; key > 0; key -= key & -key)
+        count += tree[key];
+    return count;
+}
+
+/**
+ * @brief Measure the rank error of a multi queue through the hold model from a single thread
+ * @param heaps Number of heaps the queue is built with
+ * @param mean Destination for the mean rank
+ * @param worst Destination for the largest rank
+ */
+static void measure_rank(size_t heaps, double *mean, long *worst)
+{
+    multi_queue_t *queue;
+    unsigned int seed = 1;
+    long rank, sum = 0;
+    int *tree;
+    int i, key;
+
+    queue = multi_queue_new(int_compare, heaps, 1);
+    tree = calloc(KEY_SPACE + 1, sizeof *tree);
+    if ((queue == NULL) || (tree == NULL))
+        exit(1);
+
+    for (i = 0; i < PREFILL; i++)
+    {
+        key = rand_r(&seed) % KEY_SPACE;
+        multi_queue_push(queue, &key, sizeof key);
+        tree_add(tree, key, 1);
+    }
+
+    *worst = 0;
+    for (i = 0; i < operations; i++)
+    {
+        multi_queue_pop(queue, &key);
+        tree_add(tree, key, -1);
+        rank = tree_count_below(tree, key);
+        sum += rank;
+        if (rank > *worst)
+            *worst = rank;
+        key = next_key(key, &seed);
+        multi_queue_push(queue, &key, sizeof key);
+        tree_add(tree, key, 1);
+    }
+    *mean = (double)sum / operations;
+
+    free(tree);
+    multi_queue_destroy(queue);
+}
+
+int main(int argc, char **argv)
+{
+    int max_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int factor = DEFAULT_FACTOR;
+    unsigned int seed = 1;
+    double relaxed_rate, locked_rate, mean;
+    long worst;
+    int threads, i, key;
+
+    operations = DEFAULT_OPERATIONS;
+    if (argc > 1)
+        max_threads = atoi(argv[1]);
+    if (argc > 2)
+        operations = atoi(argv[2]);
+    if (argc > 3)
+        factor = atoi(argv[3]);
+    if ((max_threads <= 0) || (operations <= 0) || (factor <= 0))
+        return 1;
+
+    if (pthread_mutex_init(&locked.lock, NULL) != 0)
+        return 1;
+
+    printf("%8s %8s %18s %18s %12s %12s\n", "threads", "heaps", "multi (Mops/s)", "mutex (Mops/s)", "mean rank", "worst rank");
+    for (threads = 1; threads <= max_threads; threads++)
+    {
+        relaxed = multi_queue_new(int_compare, threads, factor);
+        locked.queue = priority_queue_new_heap(int_compare);
+        if ((relaxed == NULL) || (locked.queue == NULL))
+            return 1;
+        for (i = 0; i < PREFILL; i++)
+        {
+            key = rand_r(&seed) % KEY_SPACE;
+            multi_queue_push(relaxed, &key, sizeof key);
+            priority_queue_push(locked.queue, &key, sizeof key);
+        }
+
+        relaxed_rate = run(threads, relaxed_worker);
+        locked_rate = run(threads, locked_worker);
+        measure_rank(multi_queue_heaps(relaxed), &mean, &worst);
+        printf("%8d %8zu %18.2f %18.2f %12.1f %12ld\n", threads, multi_queue_heaps(relaxed), relaxed_rate * 1e-6, locked_rate * 1e-6, mean, worst);
+
+        priority_queue_destroy(locked.queue);
+        multi_queue_destroy(relaxed);
+    }
+
+    pthread_mutex_destroy(&locked.lock);
+    return 0;
+}
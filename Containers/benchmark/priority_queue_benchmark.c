@@ -0,0 +1,104 @@
+/*
+ * Priority queue backend benchmark
+ *
+ * Build from the Containers directory:
+ *   gcc -O2 -I. benchmark/priority_queue_benchmark.c priority_queue.c sorted_list.c heap.c minmax_heap.c pairing_heap.c radix_heap.c sort.c -o pq_bench
+ * Usage:
+ *   ./pq_bench [max sorted list size]
+ */
+#include "priority_queue.h"
+#include "sort.h"
+#include <stdio.h>
+#include <time.h>
+
+// Pushing into the sorted list backend walks the list, so it is only measured up to this size by default
+#define SORTED_LIST_DEFAULT_LIMIT 10000
+
+/**
+ * @brief Perform integer comparison on data
+ * @param data1 First data
+ * @param data1_size First data's length
+ * @param data2 Second data
+ * @param data2_size Second data's length
+ * @return 0 if data are equal, >0 if data1 > data2, <0 if data2 > data1
+ */
+static int int_compare(void *data1, int data1_size, void *data2, int data2_size)
+{
+    int a = *(int *)data1;
+    int b = *(int *)data2;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Get a monotonic timestamp
+ * @return Seconds elapsed since an arbitrary point
+ */
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Push and then pop a number of random items through a queue
+ * @param queue Pointer to the queue structure
+ * @param count Number of items
+ * @param push_time Destination for the time spent pushing
+ * @param pop_time Destination for the time spent popping
+ */
+static void run(priority_queue_t *queue, size_t count, double *push_time, double *pop_time)
+{
+    double start;
+    size_t i;
+    int value;
+
+    srand(1);
+    start = now();
+    for (i = 0; i < count; i++)
+    {
+        value = rand();
+        priority_queue_push(queue, &value, sizeof value);
+    }
+    *push_time = now() - start;
+
+    start = now();
+    while (!priority_queue_empty(queue))
+    {
+        priority_queue_pop(queue, &value);
+    }
+    *pop_time = now() - start;
+}
+
+int main(int argc, char **argv)
+{
+    priority_queue_t *queue;
+    size_t limit = SORTED_LIST_DEFAULT_LIMIT;
+    size_t count;
+    double push_time, pop_time;
+
+    if (argc > 1)
+        limit = strtoul(argv[1], NULL, 10);
+
+    printf("%10s %12s %14s %14s\n", "items", "backend", "push (ns/op)", "pop (ns/op)");
+    for (count = 1000; count <= 1000000; count *= 10)
+    {
+        queue = priority_queue_new_heap(int_compare);
+        run(queue, count, &push_time, &pop_time);
+        printf("%10zu %12s %14.1f %14.1f\n", count, "heap", push_time * 1e9 / count, pop_time * 1e9 / count);
+        priority_queue_destroy(queue);
+
+        if (count > limit)
+        {
+            printf("%10zu %12s %14s %14s\n", count, "sorted list", "skipped", "skipped");
+            continue;
+        }
+        queue = priority_queue_new(int_compare, natural_merge_sort);
+        run(queue, count, &push_time, &pop_time);
+        printf("%10zu %12s %14.1f %14.1f\n", count, "sorted list", push_time * 1e9 / count, pop_time * 1e9 / count);
+        priority_queue_destroy(queue);
+    }
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Monotone key benchmark: radix heap queue vs comparison-based heap queues
+ *
+ * Each run fills a queue with deadlines, then repeatedly pops the earliest one and schedules a
+ * new deadline after it, the way a timer queue or Dijkstra's algorithm uses a priority queue.
+ *
+ * Build from the Containers directory:
+ *   gcc -O2 -I. benchmark/radix_heap_benchmark.c priority_queue.c sorted_list.c heap.c minmax_heap.c pairing_heap.c radix_heap.c -o radix_bench
+ * Usage:
+ *   ./radix_bench [number of operations]
+ */
+#include "priority_queue.h"
+#include <stdio.h>
+#include <time.h>
+
+#define DEFAULT_OPERATIONS 2000000
+// Deadlines are scheduled up to this far after the current time
+#define DEADLINE_RANGE 1000000
+
+static unsigned long comparisons;
+
+/**
+ * @brief Perform unsigned 64-bit integer comparison on data, counting calls
+ * @param data1 First data
+ * @param data1_size First data's length
+ * @param data2 Second data
+ * @param data2_size Second data's length
+ * @return 0 if data are equal, >0 if data1 > data2, <0 if data2 > data1
+ */
+static int u64_compare(void *data1, int data1_size, void *data2, int data2_size)
+{
+    uint64_t a = *(uint64_t *)data1;
+    uint64_t b = *(uint64_t *)data2;
+
+    comparisons++;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Get a monotonic timestamp
+ * @return Seconds elapsed since an arbitrary point
+ */
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Schedule deadlines through a queue
+ * @param queue Pointer to the queue structure
+ * @param pending Number of deadlines kept in the queue
+ * @param operations Number of pop/push pairs
+ * @return Time spent in seconds
+ */
+static double run(priority_queue_t *queue, size_t pending, size_t operations)
+{
+    uint64_t deadline;
+    double start;
+    size_t i;
+
+    srand(1);
+    for (i = 0; i < pending; i++)
+    {
+        deadline = rand() % DEADLINE_RANGE;
+        priority_queue_push(queue, &deadline, sizeof deadline);
+    }
+
+    comparisons = 0;
+    start = now();
+    for (i = 0; i < operations; i++)
+    {
+        priority_queue_pop(queue, &deadline);
+        deadline += rand() % DEADLINE_RANGE;
+        priority_queue_push(queue, &deadline, sizeof deadline);
+    }
+    return now() - start;
+}
+
+int main(int argc, char **argv)
+{
+    priority_queue_t *queue;
+    size_t operations = DEFAULT_OPERATIONS;
+    size_t pending;
+    double elapsed;
+    int backend;
+    const char *names[] = { "heap", "pairing heap", "radix heap" };
+
+    if (argc > 1)
+        operations = strtoul(argv[1], NULL, 10);
+
+    printf("%10s %14s %14s %14s\n", "pending", "backend", "ns per op", "compares/op");
+    for (pending = 1000; pending <= 1000000; pending *= 10)
+    {
+        for (backend = 0; backend < 3; backend++)
+        {
+            if (backend == 0)
+                queue = priority_queue_new_heap(u64_compare);
+            else if (backend == 1)
+                queue = priority_queue_new_pairing(u64_compare);
+            else
+                queue = priority_queue_new_radix(0);
+            elapsed = run(queue, pending, operations);
+            printf("%10zu %14s %14.1f %14.1f\n", pending, names[backend], elapsed * 1e9 / operations, (double)comparisons / operations);
+            priority_queue_destroy(queue);
+        }
+    }
+
+    return 0;
+}
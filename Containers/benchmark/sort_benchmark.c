@@ -0,0 +1,121 @@
+/*
+ * Sort benchmark: sequential natural merge sort vs parallel merge sort on 1 to N threads
+ *
+ * Build from the Containers directory:
+ *   gcc -O2 -I. benchmark/sort_benchmark.c sort.c sorted_list.c -lpthread -o sort_bench
+ * Usage:
+ *   ./sort_bench [number of items] [max threads]
+ */
+#include "sort.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_ITEM_COUNT 2000000
+
+/**
+ * @brief Perform integer comparison on data
+ * @param data1 First data
+ * @param data1_size First data's length
+ * @param data2 Second data
+ * @param data2_size Second data's length
+ * @return 0 if data are equal, >0 if data1 > data2, <0 if data2 > data1
+ */
+static int int_compare(void *data1, int data1_size, void *data2, int data2_size)
+{
+    int a = *(int *)data1;
+    int b = *(int *)data2;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Get a monotonic timestamp
+ * @return Seconds elapsed since an arbitrary point
+ */
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Chain nodes holding random keys in a fixed order
+ * @param nodes Array of nodes
+ * @param count Number of nodes
+ * @return Head of the chain
+ */
+static node_t *shuffle(node_t **nodes, int count)
+{
+    int i;
+
+    srand(1);
+    for (i = 0; i < count; i++)
+    {
+        *(int *)nodes[i]->data = rand();
+        nodes[i]->next = (i + 1 < count) ? nodes[i + 1] : NULL;
+    }
+    return nodes[0];
+}
+
+/**
+ * @brief Time a sorting function on the same random input
+ * @param nodes Array of nodes
+ * @param count Number of nodes
+ * @param sort Sorting function
+ * @return Elapsed time in seconds
+ */
+static double run(node_t **nodes, int count, sort_func_t sort)
+{
+    node_t *head = shuffle(nodes, count);
+    double start;
+
+    start = now();
+    sort(&head, int_compare);
+    return now() - start;
+}
+
+int main(int argc, char **argv)
+{
+    int count = DEFAULT_ITEM_COUNT;
+    int max_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    node_t **nodes;
+    double sequential, elapsed;
+    int i, threads;
+
+    if (argc > 1)
+        count = atoi(argv[1]);
+    if (argc > 2)
+        max_threads = atoi(argv[2]);
+    if ((count <= 0) || (max_threads <= 0))
+        return 1;
+
+    nodes = malloc(count * sizeof *nodes);
+    if (nodes == NULL)
+        return 1;
+    for (i = 0; i < count; i++)
+    {
+        nodes[i] = malloc(sizeof *nodes[i] + sizeof(int));
+        if (nodes[i] == NULL)
+            return 1;
+        nodes[i]->data = nodes[i]->payload;
+        nodes[i]->data_size = sizeof(int);
+    }
+
+    sequential = run(nodes, count, natural_merge_sort);
+    printf("%10s %12s %10s\n", "threads", "time (ms)", "speedup");
+    printf("%10s %12.1f %10.2f\n", "sequential", sequential * 1e3, 1.0);
+    for (threads = 1; threads <= max_threads; threads++)
+    {
+        parallel_sort_set_threads(threads);
+        elapsed = run(nodes, count, parallel_merge_sort);
+        printf("%10d %12.1f %10.2f\n", threads, elapsed * 1e3, sequential / elapsed);
+    }
+
+    for (i = 0; i < count; i++)
+        free(nodes[i]);
+    free(nodes);
+    return 0;
+}
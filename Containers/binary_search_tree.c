@@ -40,6 +40,7 @@ bst_node_t *bst_node_new(bst_node_t *parent, void *key, int key_size)
         new_node->left = NULL;
         new_node->right = NULL;
         new_node->key_size = key_size;
+        new_node->height = 1;
     }
 
     // Return a pointer to the new structure
@@ -79,6 +80,7 @@ bst_tree_t *bst_tree_new(compare_func_t compare)
         // Initialize the tree structure
         new_tree->root = NULL;
         new_tree->compare = compare;
+        new_tree->balanced = 0;
     }
     
     // Return a pointer to the new structure
@@ -88,46 +90,188 @@ bst_tree_t *bst_tree_new(compare_func_t compare)
     return new_tree;
 }
 
+/**
+ * @brief Balanced BST tree constructor
+ * @param compare Key comparison function
+ * @return An owning pointer that points to the new tree
+ * @note The tree is kept AVL-balanced, so its height stays O(log n) whatever the insertion order
+ */
+bst_tree_t *bst_tree_new_balanced(compare_func_t compare)
+{
+    bst_tree_t *new_tree;
+
+    new_tree = bst_tree_new(compare);
+    if (new_tree != NULL)
+    {
+        new_tree->balanced = 1;
+    }
+
+    return new_tree;
+}
+
+/**
+ * @brief Get the height of a subtree
+ * @param node Root node of the subtree
+ * @return Height of the subtree, 0 if it is empty
+ * @note Internal use only
+ */
+static int bst_height(bst_node_t *node)
+{
+    return (node != NULL) ? node->height : 0;
+}
+
+/**
+ * @brief Recompute a node's height from its children's
+ * @param node Pointer to the node
+ * @note Internal use only
+ */
+static void bst_update_height(bst_node_t *node)
+{
+    int left = bst_height(node->left);
+    int right = bst_height(node->right);
+
+    node->height = ((left > right) ? left : right) + 1;
+}
+
+/**
+ * @brief Make a node's new subtree root take its place under the node's parent
+ * @param tree Pointer to the tree structure
+ * @param node Node being rotated down
+ * @param pivot Child of the node being rotated up
+ * @note Internal use only
+ */
+static void bst_replace_child(bst_tree_t *tree, bst_node_t *node, bst_node_t *pivot)
+{
+    pivot->parent = node->parent;
+    if (node->parent == NULL)
+    {
+        tree->root = pivot;
+    }
+    else if (node->parent->left == node)
+    {
+        node->parent->left = pivot;
+    }
+    else
+    {
+        node->parent->right = pivot;
+    }
+    node->parent = pivot;
+}
+
+/**
+ * @brief Rotate a subtree to the left
+ * @param tree Pointer to the tree structure
+ * @param node Root node of the subtree, its right child becomes the new root
+ * @return The new root of the subtree
+ * @note Internal use only
+ */
+static bst_node_t *bst_rotate_left(bst_tree_t *tree, bst_node_t *node)
+{
+    bst_node_t *pivot = node->right;
+
+    node->right = pivot->left;
+    if (pivot->left != NULL)
+        pivot->left->parent = node;
+    bst_replace_child(tree, node, pivot);
+    pivot->left = node;
+
+    bst_update_height(node);
+    bst_update_height(pivot);
+    return pivot;
+}
+
+/**
+ * @brief Rotate a subtree to the right
+ * @param tree Pointer to the tree structure
+ * @param node Root node of the subtree, its left child becomes the new root
+ * @return The new root of the subtree
+ * @note Internal use only
+ */
+static bst_node_t *bst_rotate_right(bst_tree_t *tree, bst_node_t *node)
+{
+    bst_node_t *pivot = node->left;
+
+    node->left = pivot->right;
+    if (pivot->right != NULL)
+        pivot->right->parent = node;
+    bst_replace_child(tree, node, pivot);
+    pivot->right = node;
+
+    bst_update_height(node);
+    bst_update_height(pivot);
+    return pivot;
+}
+
+/**
+ * @brief Restore the AVL balance of every subtree on the path from a node to the root
+ * @param tree Pointer to the tree structure
+ * @param node Deepest node whose subtree may have become unbalanced
+ * @note Internal use only
+ */
+static void bst_rebalance(bst_tree_t *tree, bst_node_t *node)
+{
+    int balance;
+
+    while (node != NULL)
+    {
+        bst_update_height(node);
+        balance = bst_height(node->left) - bst_height(node->right);
+        if (balance > 1)
+        {
+            // Left-heavy, a left-right case needs its left child rotated first
+            if (bst_height(node->left->left) < bst_height(node->left->right))
+                bst_rotate_left(tree, node->left);
+            node = bst_rotate_right(tree, node);
+        }
+        else if (balance < -1)
+        {
+            // Right-heavy, a right-left case needs its right child rotated first
+            if (bst_height(node->right->right) < bst_height(node->right->left))
+                bst_rotate_right(tree, node->right);
+            node = bst_rotate_left(tree, node);
+        }
+        node = node->parent;
+    }
+}
+
 /**
  * @brief Destroy all nodes in a tree
  * @param node Pointer to the current tree's root
+ * @note Walks the tree in post-order through parent links, O(n) with constant stack usage
  */
 static void bst_tree_destroy_all(bst_node_t *node)
 {
     bst_node_t *parent;
 
-    if (node == NULL)
-        return;
-
-    // A node can be destroyed when it has no remaining links to any children
-    parent = node->parent;
-    if ((node->left == NULL) && (node->right == NULL))
+    while (node != NULL)
     {
-        if (parent != NULL)
+        // Descend until a node with no remaining links to any children is found
+        if (node->left != NULL)
         {
-            // Remove links from parent node
-            if (parent->left == node)
-            {
-                parent->left = NULL;
-            }
-            else
+            node = node->left;
+        }
+        else if (node->right != NULL)
+        {
+            node = node->right;
+        }
+        else
+        {
+            // Remove links from parent node, then destroy this node and resume from its parent
+            parent = node->parent;
+            if (parent != NULL)
             {
-                parent->right = NULL;
+                if (parent->left == node)
+                {
+                    parent->left = NULL;
+                }
+                else
+                {
+                    parent->right = NULL;
+                }
             }
-            
-            // Destroy this node's parent's subtree
-            bst_tree_destroy_all(parent);
+            bst_node_destroy(node);
+            node = parent;
         }
-        // Destroy this node
-        bst_node_destroy(node);
-    }
-    else if (node->left)
-    {
-        bst_tree_destroy_all(node->left);
-    }
-    else
-    {
-        bst_tree_destroy_all(node->right);
     }
 }
 
@@ -146,31 +290,64 @@ void bst_tree_destroy(bst_tree_t * tree)
 /**
  * @brief Insert a new node with a given key into a tree
  * @param tree Pointer to tree structure
- * @param current Pointer to current node
+ * @param current Pointer to the root of the subtree to insert into
  * @param parent Pointer to current node's parent node
  * @param key New node's key
  * @param key_size Size of the key in bytes
- * @return A pointer to the current node after the insertion
+ * @return A pointer to the current node after the insertion, or to the new node if current was NULL
+ * @note An empty tree takes the new node as its root
+ * @note Balanced trees always insert from their root and update it, then return it
  */
 bst_node_t *bst_tree_insert(bst_tree_t *tree, bst_node_t * current, bst_node_t *parent, void *key, int key_size)
 {
-    // If the tree is empty, return a new node
+    bst_node_t **link;
+    bst_node_t *new_node;
+
+    // Rotations may reach the root, so balanced trees always start from it
+    if (tree->balanced)
+    {
+        current = tree->root;
+        parent = NULL;
+    }
+
+    // If the subtree is empty, return a new node
     if (current == NULL)
     {
-        return bst_node_new(parent, key, key_size);
+        new_node = bst_node_new(parent, key, key_size);
+        if ((parent == NULL) && (tree->root == NULL))
+            tree->root = new_node;
+        return new_node;
     }
-    else
+
+    // Descend to the empty link the key belongs in
+    parent = current;
+    for (;;)
     {
-        if (tree->compare(current->key, current->key_size, key, key_size) > 0)
+        if (tree->compare(parent->key, parent->key_size, key, key_size) > 0)
         {
             // If the key is smaller than the current key, descend into the left subtree
-            current->left = bst_tree_insert(tree, current->left, current, key, key_size);
+            link = &parent->left;
         }
         else // Assumes no duplicates
         {
             // If the key is greater than the current key, descend into the right subtree
-            current->right = bst_tree_insert(tree, current->right, current, key, key_size);
+            link = &parent->right;
         }
+        if (*link == NULL)
+            break;
+        parent = *link;
+    }
+
+    new_node = bst_node_new(parent, key, key_size);
+    if (new_node == NULL)
+        return current;
+    *link = new_node;
+
+    if (tree->balanced)
+    {
+        // Rotate unbalanced subtrees back into shape on the way up
+        bst_rebalance(tree, parent);
+        return tree->root;
     }
 
     // Return the unchanged current node pointer
@@ -187,23 +364,23 @@ bst_node_t *bst_tree_insert(bst_tree_t *tree, bst_node_t * current, bst_node_t *
  */
 bst_node_t *bst_tree_search(bst_tree_t *tree, bst_node_t *root, void *key, int key_size)
 {
+    int cmp;
+
     if ((key == NULL) || (key_size == 0))
     {
         return NULL;
     }
 
-    // If root is NULL or key is present at root node
-    if ((root == NULL) || (tree->compare(root->key, root->key_size, key, key_size) == 0))
+    while (root != NULL)
     {
-        return root;
-    }
+        // Stop if key is present at root node
+        cmp = tree->compare(root->key, root->key_size, key, key_size);
+        if (cmp == 0)
+            return root;
 
-    // If the key is smaller than the root key, continue searching the left subtree
-    if (tree->compare(root->key, root->key_size, key, key_size) > 0)
-    {
-        return bst_tree_search(tree, root->left, key, key_size);
+        // If the key is smaller than the root key, continue with the left subtree, otherwise with the right one
+        root = (cmp > 0) ? root->left : root->right;
     }
 
-    // The key is greater than the root key, continue searching the right subtree
-    return bst_tree_search(tree, root->right, key, key_size);
+    return NULL;
 }
@@ -2,36 +2,30 @@
 #include <string.h>
 #ifdef DEBUG
 #include <stdio.h>
+#include <assert.h>
 #endif
 
 /**
  * @brief Node constructor
- * @param data Data to be stored within the new node
  * @param data_size Size of the datatype stored within the new node in bytes
- * @return An owning pointer that points to the new node
+ * @return An owning pointer that points to the new node, its data is left for the caller to fill
  * @note Internal use only
  */
-static node_t *node_new(void *data, size_t data_size)
+static node_t *node_new(size_t data_size)
 {
     node_t *new_node;
 
     // Empty list items aren't supported
-    if ((data == NULL) || (data_size == 0))
+    if (data_size == 0)
         return NULL;
 
-    // Reserve memory for the new node
-    new_node = malloc(sizeof *new_node);
+    // Reserve memory for the new node and its encapsulated data in a single block
+    new_node = malloc(sizeof *new_node + data_size);
     if (new_node != NULL)
     {
-        // Also reserve memory for the encapsulated data
-        new_node->data = malloc(data_size);
-        if (new_node->data == NULL)
-        {
-            free(new_node);
-            return NULL;
-        }
-        // Initialize the structure
-        memcpy(new_node->data, data, data_size);
+        // Initialize the structure, data is stored inline right after the links
+        new_node->data = new_node->payload;
+        new_node->data_size = data_size;
         new_node->next = NULL;
     }
 
@@ -51,8 +45,7 @@ static void node_destroy(node_t *node)
 {
     if (node != NULL)
     {
-        // Free memory allocated to the node structure and its internal data
-        free(node->data);
+        // Data is stored inline, so a single block holds the whole node
         free(node);
 #ifdef DEBUG
     printf("Destroyed node at %lx\n", (unsigned long int)node);
@@ -74,6 +67,8 @@ forward_list_t *forward_list_new()
     {
         // Initialize the structure
         new_list->head = NULL;
+        new_list->tail = NULL;
+        new_list->size = 0;
     }
 
     // Return a pointer to the new list structure
@@ -121,18 +116,24 @@ int forward_list_empty(forward_list_t *list)
  */
 size_t forward_list_size(forward_list_t *list)
 {
+#ifdef DEBUG
     size_t ret = 0;
     node_t *iterator;
+    node_t *last = NULL;
 
-    // Traverse the list counting the nodes
+    // Validate the item counter and the tail pointer against a full traversal
     iterator = list->head;
     while (iterator != NULL)
     {
         ret++;
+        last = iterator;
         iterator = iterator->next;
     }
-
-    return ret;
+    assert(ret == list->size);
+    assert(last == list->tail);
+#endif
+    // Every mutating operation keeps the item counter up to date
+    return list->size;
 }
 
 /**
@@ -156,19 +157,44 @@ int forward_list_add(forward_list_t *list, void *data, size_t data_size)
  * @return 0 on success, -1 on error
  */
 int forward_list_push_front(forward_list_t *list, void *data, size_t data_size)
+{
+    void *dest;
+
+    if (data == NULL)
+        return -1;
+
+    // Reserve the new item in place, then fill it
+    dest = forward_list_emplace_front(list, data_size);
+    if (dest == NULL)
+        return -1;
+    memcpy(dest, data, data_size);
+
+    return 0;
+}
+
+/**
+ * @brief Insert an uninitialized item at the front of a list
+ * @param list Pointer to the list structure
+ * @param data_size Size of the new item in bytes
+ * @return A pointer to the new item's data for the caller to fill, NULL on error
+ */
+void *forward_list_emplace_front(forward_list_t *list, size_t data_size)
 {
     node_t *new_item;
 
     // Create a new node to encapsulate the data
-    new_item = node_new(data, data_size);
+    new_item = node_new(data_size);
     if (new_item == NULL)
-        return -1;
+        return NULL;
 
-    // The new node becomes head
+    // The new node becomes head, and also tail if the list was empty
     new_item->next = list->head;
     list->head = new_item;
+    if (list->tail == NULL)
+        list->tail = new_item;
+    list->size++;
 
-    return 0;
+    return new_item->data;
 }
 
 /**
@@ -187,7 +213,14 @@ void forward_list_pop_front(forward_list_t *list, void *dest)
     // The next node on the list becomes the new head
     popped_node = list->head;
     list->head = popped_node->next;
-    
+    if (list->head == NULL)
+    {
+        // If the list is now empty, tail must also be NULL
+        list->tail = NULL;
+    }
+
+    list->size--;
+
     // Data from the popped node is copied into destination if provided
     if (dest != NULL)
     {
@@ -214,6 +247,17 @@ int forward_list_peek_front(forward_list_t *list, void *dest)
     return -1;
 }
 
+/**
+ * @brief Get a pointer to the item at the front of a list
+ * @param list Pointer to the list structure
+ * @return A pointer to the item's data, NULL if the list is empty
+ * @note The pointer is valid until the item is removed
+ */
+void *forward_list_front_ptr(forward_list_t *list)
+{
+    return ((list != NULL) && (list->head != NULL)) ? list->head->data : NULL;
+}
+
 /**
  * @brief Insert an item at the back of a list
  * @param list Pointer to the list structure
@@ -222,39 +266,57 @@ int forward_list_peek_front(forward_list_t *list, void *dest)
  * @return 0 on success, -1 on error
  */
 int forward_list_push_back(forward_list_t *list, void *data, size_t data_size)
+{
+    void *dest;
+
+    if (data == NULL)
+        return -1;
+
+    // Reserve the new item in place, then fill it
+    dest = forward_list_emplace_back(list, data_size);
+    if (dest == NULL)
+        return -1;
+    memcpy(dest, data, data_size);
+
+    return 0;
+}
+
+/**
+ * @brief Insert an uninitialized item at the back of a list
+ * @param list Pointer to the list structure
+ * @param data_size Size of the new item in bytes
+ * @return A pointer to the new item's data for the caller to fill, NULL on error
+ */
+void *forward_list_emplace_back(forward_list_t *list, size_t data_size)
 {
     node_t *new_item;
-    node_t *current_item;
 
     // Create a new node to encapsulate the data
-    new_item = node_new(data, data_size);
+    new_item = node_new(data_size);
     if (new_item == NULL)
-        return -1;
+        return NULL;
 
-    // If the list was empty, the new node becomes head
-    current_item = list->head;
-    if (current_item == NULL)
+    // If the list was empty, the new node becomes head and tail
+    if (list->tail == NULL)
     {
         list->head = new_item;
     }
     else
     {
-        // Find the last item on the list
-        while (current_item->next != NULL)
-        {
-            current_item = current_item->next;
-        }
-        // The new node becomes the next item to that one
-        current_item->next = new_item;
+        // Otherwise, the new node becomes the next item to the tail
+        list->tail->next = new_item;
     }
+    list->tail = new_item;
+    list->size++;
 
-    return 0;
+    return new_item->data;
 }
 
 /**
  * @brief Extract the item at the back of a list
  * @param list Pointer to the list structure
  * @param dest Destination
+ * @note Nodes don't link back, so finding the new tail is still O(n)
  */
 void forward_list_pop_back(forward_list_t *list, void *dest)
 {
@@ -265,26 +327,27 @@ void forward_list_pop_back(forward_list_t *list, void *dest)
     if ((list == NULL) || (list->head == NULL))
         return;
 
-    // Find the last item on the list
-    iterator = list->head;
-    while (iterator->next != NULL)
+    popped_node = list->tail;
+    if (list->head == popped_node)
     {
-        if (iterator->next->next == NULL)
-        {
-            // The second to last node shall no longer have a node after it
-            popped_node = iterator->next;
-            iterator->next = NULL;
-            break;
-        }
-        iterator = iterator->next;
+        // If the list is now empty, head and tail must be NULL
+        list->head = NULL;
+        list->tail = NULL;
     }
-    
-    // If the list is now empty, head must be NULL
-    if (iterator == list->head)
+    else
     {
-        list->head = NULL;
+        // Find the second to last node, which shall no longer have a node after it
+        iterator = list->head;
+        while (iterator->next != popped_node)
+        {
+            iterator = iterator->next;
+        }
+        iterator->next = NULL;
+        list->tail = iterator;
     }
 
+    list->size--;
+
     // Data from the popped node is copied into destination if provided
     if (dest != NULL)
     {
@@ -302,23 +365,56 @@ void forward_list_pop_back(forward_list_t *list, void *dest)
  */
 int forward_list_peek_back(forward_list_t *list, void *dest)
 {
-    node_t *iterator;
-
-    if ((list != NULL) && (list->head != NULL) && (dest != NULL))
+    if ((list != NULL) && (list->tail != NULL) && (dest != NULL))
     {
-        // Find the last item on the list
-        iterator = list->head;
-        while (iterator->next != NULL)
-        {
-            iterator = iterator->next;
-        }
         // Copy peeked data into its destination
-        memcpy(dest, iterator->data, iterator->data_size);
+        memcpy(dest, list->tail->data, list->tail->data_size);
         return 0;
     }
     return -1;
 }
 
+/**
+ * @brief Get a pointer to the item at the back of a list
+ * @param list Pointer to the list structure
+ * @return A pointer to the item's data, NULL if the list is empty
+ * @note The pointer is valid until the item is removed
+ */
+void *forward_list_back_ptr(forward_list_t *list)
+{
+    return ((list != NULL) && (list->tail != NULL)) ? list->tail->data : NULL;
+}
+
+/**
+ * @brief Move every item of a list to the back of another one
+ * @param list Pointer to the destination list structure
+ * @param other Pointer to the source list structure, left empty
+ * @return 0 on success, -1 on error
+ * @note Nodes are relinked without touching their data, O(1)
+ */
+int forward_list_concat(forward_list_t *list, forward_list_t *other)
+{
+    if ((list == NULL) || (other == NULL) || (list == other))
+        return -1;
+    if (other->head == NULL)
+        return 0;
+
+    // If the destination was empty, the source's head becomes its head
+    if (list->tail == NULL)
+        list->head = other->head;
+    else
+        list->tail->next = other->head;
+    list->tail = other->tail;
+    list->size += other->size;
+
+    // The source list no longer owns any node
+    other->head = NULL;
+    other->tail = NULL;
+    other->size = 0;
+
+    return 0;
+}
+
 /**
  * @brief Clear a list's contents
  * @param list Pointer to the list structure
@@ -334,4 +430,6 @@ void forward_list_clear(forward_list_t *list)
         forward_list_pop_front(list, NULL);
     }
     list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
 }
@@ -2,6 +2,7 @@
 #define _FORWARD_forward_list_H
 
 #include <stdlib.h>
+#include <stddef.h>
 
 typedef struct node node_t;
 
@@ -10,11 +11,15 @@ struct node
     void *data;
     size_t data_size;
     node_t *next;
+    // Inline data starts at an address suitable for any type, like a malloc block
+    _Alignas(max_align_t) unsigned char payload[];
 };
 
 typedef struct forward_list
 {
     node_t *head;
+    node_t *tail;
+    size_t size;
 } forward_list_t;
 
 forward_list_t *forward_list_new();
@@ -23,11 +28,16 @@ int forward_list_empty(forward_list_t *list);
 size_t forward_list_size(forward_list_t *list);
 int forward_list_add(forward_list_t *list, void *data, size_t data_size);
 int forward_list_push_front(forward_list_t *list, void *data, size_t data_size);
+void *forward_list_emplace_front(forward_list_t *list, size_t data_size);
 void forward_list_pop_front(forward_list_t *list, void *dest);
 int forward_list_peek_front(forward_list_t *list, void *dest);
+void *forward_list_front_ptr(forward_list_t *list);
 int forward_list_push_back(forward_list_t *list, void *data, size_t data_size);
+void *forward_list_emplace_back(forward_list_t *list, size_t data_size);
 void forward_list_pop_back(forward_list_t *list, void *dest);
 int forward_list_peek_back(forward_list_t *list, void *dest);
+void *forward_list_back_ptr(forward_list_t *list);
+int forward_list_concat(forward_list_t *list, forward_list_t *other);
 void forward_list_clear(forward_list_t *list);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,533 @@
+#include "hash_map.h"
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#ifdef DEBUG
+#include <stdio.h>
+#endif
+
+// Control byte values, full slots hold the 7 low bits of their key's hash instead
+#define CTRL_EMPTY ((signed char)-128)
+#define CTRL_DELETED ((signed char)-2)
+#define HASH_MAP_MIN_CAPACITY HASH_MAP_GROUP_WIDTH
+
+/**
+ * @brief Default hash function, mixes the key 8 bytes at a time
+ * @param key Key to hash
+ * @param key_size Size of the key in bytes
+ * @return Hash of the key
+ * @note Internal use only
+ */
+static uint64_t hash_bytes(void *key, int key_size)
+{
+    const unsigned char *bytes = key;
+    uint64_t hash = 0x9e3779b97f4a7c15ULL ^ (uint64_t)key_size;
+    uint64_t word;
+
+    while (key_size > 0)
+    {
+        word = 0;
+        memcpy(&word, bytes, (key_size < 8) ? key_size : 8);
+        hash = (hash ^ word) * 0xbf58476d1ce4e5b9ULL;
+        hash ^= hash >> 29;
+        bytes += 8;
+        key_size -= 8;
+    }
+
+    // Final avalanche, both the low bits and the high bits of the result are used
+    hash ^= hash >> 32;
+    hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief Find the control bytes of a group that hold a given value
+ * @param group First control byte of the group
+ * @param value Value to look for
+ * @return A mask with bit i set if the group's i-th control byte matches
+ * @note Compares the whole group with a single SSE2 instruction. Internal use only
+ */
+static uint32_t group_match(const signed char *group, signed char value)
+{
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value)));
+}
+
+/**
+ * @brief Find the empty or deleted slots of a group
+ * @param group First control byte of the group
+ * @return A mask with bit i set if the group's i-th slot is not full
+ * @note Only those control bytes have their sign bit set. Internal use only
+ */
+static uint32_t group_match_free(const signed char *group)
+{
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+}
+#else
+/**
+ * @brief Find the control bytes of a group that hold a given value
+ * @param group First control byte of the group
+ * @param value Value to look for
+ * @return A mask with bit i set if the group's i-th control byte matches
+ * @note Portable fallback for targets without SSE2. Internal use only
+ */
+static uint32_t group_match(const signed char *group, signed char value)
+{
+    uint32_t mask = 0;
+    int i;
+
+    for (i = 0; i < HASH_MAP_GROUP_WIDTH; i++)
+    {
+        if (group[i] == value)
+            mask |= 1u << i;
+    }
+    return mask;
+}
+
+/**
+ * @brief Find the empty or deleted slots of a group
+ * @param group First control byte of the group
+ * @return A mask with bit i set if the group's i-th slot is not full
+ * @note Portable fallback for targets without SSE2. Internal use only
+ */
+static uint32_t group_match_free(const signed char *group)
+{
+    uint32_t mask = 0;
+    int i;
+
+    for (i = 0; i < HASH_MAP_GROUP_WIDTH; i++)
+    {
+        if (group[i] < 0)
+            mask |= 1u << i;
+    }
+    return mask;
+}
+#endif
+
+/**
+ * @brief Count the trailing zero bits of a group mask
+ * @param mask Group mask, must not be 0
+ * @return Position of the lowest set bit
+ * @note Internal use only
+ */
+static int trailing_zeros(uint32_t mask)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    int count = 0;
+
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Count the leading zero bits of a group mask
+ * @param mask Group mask, must not be 0
+ * @return Number of clear bits above the highest set bit, within the group's width
+ * @note Internal use only
+ */
+static int leading_zeros(uint32_t mask)
+{
+    int count = 0;
+
+    while ((mask & (1u << (HASH_MAP_GROUP_WIDTH - 1))) == 0)
+    {
+        mask <<= 1;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Get the largest number of items a table of a given capacity holds before growing
+ * @param capacity Number of slots
+ * @return Maximum number of items, 7/8 of the slots
+ * @note Internal use only
+ */
+static size_t max_load(size_t capacity)
+{
+    return capacity - capacity / 8;
+}
+
+/**
+ * @brief Get a pointer to a slot
+ * @param map Pointer to the map structure
+ * @param index Position of the slot
+ * @return A pointer to the slot, which starts with its key's size
+ * @note Internal use only
+ */
+static unsigned char *slot_at(hash_map_t *map, size_t index)
+{
+    return map->slots + index * map->slot_size;
+}
+
+/**
+ * @brief Write the control byte of a slot
+ * @param map Pointer to the map structure
+ * @param index Position of the slot
+ * @param value New control byte
+ * @note The first group is mirrored past the end, so probes that wrap around read a single group.
+ *       Internal use only
+ */
+static void set_ctrl(hash_map_t *map, size_t index, signed char value)
+{
+    map->ctrl[index] = value;
+    if (index < HASH_MAP_GROUP_WIDTH)
+        map->ctrl[map->capacity + index] = value;
+}
+
+/**
+ * @brief Look for the slot holding a given key
+ * @param map Pointer to the map structure
+ * @param key Key to search for
+ * @param key_size Size of the key in bytes
+ * @param hash Hash of the key
+ * @return Position of the slot, or the map's capacity if the key wasn't found
+ * @note Internal use only
+ */
+static size_t find_index(hash_map_t *map, void *key, int key_size, uint64_t hash)
+{
+    size_t mask = map->capacity - 1;
+    size_t position = (size_t)(hash >> 7) & mask;
+    size_t step = 0;
+    size_t index;
+    unsigned char *slot;
+    uint32_t matches;
+    int slot_key_size;
+
+    for (;;)
+    {
+        // Only slots whose control byte matches the hash's low bits can hold the key
+        matches = group_match(map->ctrl + position, (signed char)(hash & 0x7f));
+        while (matches != 0)
+        {
+            index = (position + trailing_zeros(matches)) & mask;
+            slot = slot_at(map, index);
+            memcpy(&slot_key_size, slot, sizeof slot_key_size);
+            if ((slot_key_size == key_size) && (memcmp(slot + sizeof slot_key_size, key, key_size) == 0))
+                return index;
+            matches &= matches - 1;
+        }
+
+        // The key would have been inserted in an empty slot of this group
+        if (group_match(map->ctrl + position, CTRL_EMPTY) != 0)
+            return map->capacity;
+
+        // Triangular probing visits every group once
+        step += HASH_MAP_GROUP_WIDTH;
+        position = (position + step) & mask;
+    }
+}
+
+/**
+ * @brief Look for the first empty or deleted slot on a key's probe sequence
+ * @param map Pointer to the map structure
+ * @param hash Hash of the key
+ * @return Position of the slot
+ * @note The table always has empty slots. Internal use only
+ */
+static size_t find_free(hash_map_t *map, uint64_t hash)
+{
+    size_t mask = map->capacity - 1;
+    size_t position = (size_t)(hash >> 7) & mask;
+    size_t step = 0;
+    uint32_t free_slots;
+
+    while ((free_slots = group_match_free(map->ctrl + position)) == 0)
+    {
+        step += HASH_MAP_GROUP_WIDTH;
+        position = (position + step) & mask;
+    }
+    return (position + trailing_zeros(free_slots)) & mask;
+}
+
+/**
+ * @brief Move every item into a new table
+ * @param map Pointer to the map structure
+ * @param capacity Number of slots of the new table, a power of two
+ * @return 0 on success, -1 on error
+ * @note Deleted slots are dropped on the way. Internal use only
+ */
+static int rehash(hash_map_t *map, size_t capacity)
+{
+    signed char *old_ctrl = map->ctrl;
+    unsigned char *old_slots = map->slots;
+    size_t old_capacity = map->capacity;
+    unsigned char *slot;
+    uint64_t hash;
+    size_t i, index;
+    int key_size;
+
+    // Reserve memory for the new control bytes and slots
+    map->ctrl = malloc(capacity + HASH_MAP_GROUP_WIDTH);
+    map->slots = malloc(capacity * map->slot_size);
+    if ((map->ctrl == NULL) || (map->slots == NULL))
+    {
+        free(map->ctrl);
+        free(map->slots);
+        map->ctrl = old_ctrl;
+        map->slots = old_slots;
+        return -1;
+    }
+    memset(map->ctrl, CTRL_EMPTY, capacity + HASH_MAP_GROUP_WIDTH);
+    map->capacity = capacity;
+    map->growth_left = max_load(capacity) - map->size;
+
+    // Reinsert every full slot, no key can be found twice so no lookup is needed
+    for (i = 0; i < old_capacity; i++)
+    {
+        if (old_ctrl[i] < 0)
+            continue;
+        slot = old_slots + i * map->slot_size;
+        memcpy(&key_size, slot, sizeof key_size);
+        hash = map->hash(slot + sizeof key_size, key_size);
+        index = find_free(map, hash);
+        set_ctrl(map, index, (signed char)(hash & 0x7f));
+        memcpy(slot_at(map, index), slot, map->slot_size);
+    }
+
+    free(old_ctrl);
+    free(old_slots);
+#ifdef DEBUG
+    printf("Rehashed map at %lx into %zu slots\n", (unsigned long int)map, capacity);
+#endif
+    return 0;
+}
+
+/**
+ * @brief Hash map constructor
+ * @param key_capacity Size in bytes of the largest key the map accepts
+ * @param value_size Size in bytes of every value, may be 0 to use the map as a set
+ * @param hash Hash function, NULL for the default byte-wise hash
+ * @return An owning pointer that points to the new map on success, NULL on error
+ * @note Open addressing with Swiss table style control bytes: slots are probed a group of 16 at a time.
+ *       Keys and values are stored inline in the slots. Keys are compared byte-wise,
+ *       so padding bytes within keys must be initialized.
+ */
+hash_map_t *hash_map_new(int key_capacity, int value_size, hash_func_t hash)
+{
+    hash_map_t *new_map;
+
+    // Empty keys aren't supported
+    if ((key_capacity <= 0) || (value_size < 0))
+        return NULL;
+
+    // Reserve memory for the new map structure
+    new_map = malloc(sizeof *new_map);
+    if (new_map != NULL)
+    {
+        // Values are aligned like pointers within their slot, and so are slots
+        new_map->value_offset = (sizeof(int) + key_capacity + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+        new_map->slot_size = (new_map->value_offset + value_size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+        new_map->key_capacity = key_capacity;
+        new_map->value_size = value_size;
+        new_map->hash = (hash != NULL) ? hash : hash_bytes;
+        new_map->ctrl = NULL;
+        new_map->slots = NULL;
+        new_map->capacity = 0;
+        new_map->size = 0;
+
+        // Also reserve memory for the smallest table
+        if (rehash(new_map, HASH_MAP_MIN_CAPACITY) != 0)
+        {
+            free(new_map);
+            return NULL;
+        }
+    }
+
+    // Return a pointer to the new map structure
+#ifdef DEBUG
+    printf("Created map at %lx\n", (unsigned long int)new_map);
+#endif
+    return new_map;
+}
+
+/**
+ * @brief Hash map destructor
+ * @param map Pointer to the map structure to be destroyed
+ */
+void hash_map_destroy(hash_map_t *map)
+{
+    if (map != NULL)
+    {
+        free(map->ctrl);
+        free(map->slots);
+        free(map);
+#ifdef DEBUG
+        printf("Destroyed map at %lx\n", (unsigned long int)map);
+#endif
+    }
+}
+
+/**
+ * @brief Check if a map contains no items
+ * @param map Pointer to the map structure
+ * @return 1 for empty, 0 otherwise
+ */
+int hash_map_empty(hash_map_t *map)
+{
+    return (map->size == 0) ? 1 : 0;
+}
+
+/**
+ * @brief Check the number of items a map contains
+ * @param map Pointer to the map structure
+ * @return Number of items contained in the map
+ */
+size_t hash_map_size(hash_map_t *map)
+{
+    return map->size;
+}
+
+/**
+ * @brief Insert a key and its value into a map, or replace the value of a key already in it
+ * @param map Pointer to the map structure
+ * @param key Key of the item
+ * @param key_size Size of the key in bytes, up to the map's key capacity
+ * @param value Value to be copied into the map, value_size bytes long. NULL to zero it
+ * @return 0 if the key was inserted, 1 if its value was replaced, -1 on error
+ */
+int hash_map_insert(hash_map_t *map, void *key, int key_size, void *value)
+{
+    unsigned char *slot;
+    uint64_t hash;
+    size_t index;
+    int inserted = 0;
+
+    // Empty and oversized keys aren't supported
+    if ((key == NULL) || (key_size <= 0) || (key_size > map->key_capacity))
+        return -1;
+
+    // A key already in the map only gets its value replaced
+    hash = map->hash(key, key_size);
+    index = find_index(map, key, key_size, hash);
+    if (index == map->capacity)
+    {
+        // Taking an empty slot uses up room, without any left the table grows or drops its deleted slots
+        index = find_free(map, hash);
+        if ((map->growth_left == 0) && (map->ctrl[index] == CTRL_EMPTY))
+        {
+            if (rehash(map, (map->size + 1 > max_load(map->capacity) / 2) ? map->capacity * 2 : map->capacity) != 0)
+                return -1;
+            index = find_free(map, hash);
+        }
+        if (map->ctrl[index] == CTRL_EMPTY)
+            map->growth_left--;
+        set_ctrl(map, index, (signed char)(hash & 0x7f));
+        map->size++;
+
+        slot = slot_at(map, index);
+        memcpy(slot, &key_size, sizeof key_size);
+        memcpy(slot + sizeof key_size, key, key_size);
+        inserted = 1;
+    }
+
+    slot = slot_at(map, index);
+    if (value != NULL)
+        memcpy(slot + map->value_offset, value, map->value_size);
+    else
+        memset(slot + map->value_offset, 0, map->value_size);
+
+    return inserted ? 0 : 1;
+}
+
+/**
+ * @brief Look up the value of a key in a map
+ * @param map Pointer to the map structure
+ * @param key Key to search for
+ * @param key_size Size of the key in bytes
+ * @return A pointer to the value stored in the map, NULL if the key wasn't found
+ * @note The pointer is valid until the next insertion, erasure or reservation
+ */
+void *hash_map_find(hash_map_t *map, void *key, int key_size)
+{
+    size_t index;
+
+    if ((key == NULL) || (key_size <= 0) || (key_size > map->key_capacity))
+        return NULL;
+
+    index = find_index(map, key, key_size, map->hash(key, key_size));
+    return (index != map->capacity) ? slot_at(map, index) + map->value_offset : NULL;
+}
+
+/**
+ * @brief Remove a key and its value from a map
+ * @param map Pointer to the map structure
+ * @param key Key to remove
+ * @param key_size Size of the key in bytes
+ * @return 0 on success, -1 if the key wasn't found
+ */
+int hash_map_erase(hash_map_t *map, void *key, int key_size)
+{
+    size_t mask = map->capacity - 1;
+    uint32_t empty_before, empty_after;
+    size_t index;
+
+    if ((key == NULL) || (key_size <= 0) || (key_size > map->key_capacity))
+        return -1;
+
+    index = find_index(map, key, key_size, map->hash(key, key_size));
+    if (index == map->capacity)
+        return -1;
+
+    // A probe only ever went past this slot if it was part of a group with no empty slot.
+    // Otherwise the slot can become empty again, else it must be marked deleted
+    empty_before = group_match(map->ctrl + ((index - HASH_MAP_GROUP_WIDTH) & mask), CTRL_EMPTY);
+    empty_after = group_match(map->ctrl + index, CTRL_EMPTY);
+    if ((empty_before != 0) && (empty_after != 0)
+        && (trailing_zeros(empty_after) + leading_zeros(empty_before) < HASH_MAP_GROUP_WIDTH))
+    {
+        set_ctrl(map, index, CTRL_EMPTY);
+        map->growth_left++;
+    }
+    else
+    {
+        set_ctrl(map, index, CTRL_DELETED);
+    }
+    map->size--;
+
+    return 0;
+}
+
+/**
+ * @brief Make room for a number of items in a map
+ * @param map Pointer to the map structure
+ * @param count Number of items the map must hold without growing
+ * @return 0 on success, -1 on error
+ */
+int hash_map_reserve(hash_map_t *map, size_t count)
+{
+    size_t capacity = map->capacity;
+
+    while (max_load(capacity) < count)
+    {
+        capacity *= 2;
+    }
+    if (capacity == map->capacity)
+        return 0;
+    return rehash(map, capacity);
+}
+
+/**
+ * @brief Clear a map's contents
+ * @param map Pointer to the map structure
+ * @note The table keeps its capacity
+ */
+void hash_map_clear(hash_map_t *map)
+{
+#ifdef DEBUG
+    printf("Clearing map...\n");
+#endif
+    memset(map->ctrl, CTRL_EMPTY, map->capacity + HASH_MAP_GROUP_WIDTH);
+    map->size = 0;
+    map->growth_left = max_load(map->capacity);
+}
@@ -0,0 +1,38 @@
+#ifndef _HASH_MAP_H
+#define _HASH_MAP_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+// Number of control bytes probed at once, one SSE2 register
+#define HASH_MAP_GROUP_WIDTH 16
+
+typedef uint64_t (*hash_func_t) (void *key, int key_size);
+
+typedef struct hash_map
+{
+    // One control byte per slot, followed by a copy of the first group for probes that wrap around
+    signed char *ctrl;
+    // Every slot holds the key's size, the key and the value
+    unsigned char *slots;
+    size_t capacity;
+    size_t size;
+    size_t growth_left;
+    size_t slot_size;
+    size_t value_offset;
+    int key_capacity;
+    int value_size;
+    hash_func_t hash;
+} hash_map_t;
+
+hash_map_t *hash_map_new(int key_capacity, int value_size, hash_func_t hash);
+void hash_map_destroy(hash_map_t *map);
+int hash_map_empty(hash_map_t *map);
+size_t hash_map_size(hash_map_t *map);
+int hash_map_insert(hash_map_t *map, void *key, int key_size, void *value);
+void *hash_map_find(hash_map_t *map, void *key, int key_size);
+int hash_map_erase(hash_map_t *map, void *key, int key_size);
+int hash_map_reserve(hash_map_t *map, size_t count);
+void hash_map_clear(hash_map_t *map);
+
+#endif
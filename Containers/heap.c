@@ -0,0 +1,363 @@
+#include "heap.h"
+#include <string.h>
+#ifdef DEBUG
+#include <stdio.h>
+#endif
+
+// Number of children per heap node, a 4-ary heap halves the depth of a binary one
+#define HEAP_ARITY 4
+#define HEAP_INITIAL_CAPACITY 16
+
+/**
+ * @brief Node constructor
+ * @param data Data to be stored within the new node
+ * @param data_size Size of the datatype stored within the new node in bytes
+ * @return An owning pointer that points to the new node
+ * @note Internal use only
+ */
+static node_t *node_new(void *data, size_t data_size)
+{
+    node_t *new_node;
+
+    // Empty heap items aren't supported
+    if ((data == NULL) || (data_size == 0))
+        return NULL;
+
+    // Reserve memory for the new node and its encapsulated data in a single block
+    new_node = malloc(sizeof *new_node + data_size);
+    if (new_node != NULL)
+    {
+        // Initialize the structure, heap nodes are never chained
+        new_node->data = new_node->payload;
+        memcpy(new_node->data, data, data_size);
+        new_node->data_size = data_size;
+        new_node->next = NULL;
+    }
+
+    return new_node;
+}
+
+/**
+ * @brief Check if a node must be placed above another one
+ * @param heap Pointer to the heap structure
+ * @param a First node
+ * @param b Second node
+ * @return Non-zero if a has priority over b
+ * @note Internal use only
+ */
+static int node_before(heap_t *heap, node_t *a, node_t *b)
+{
+    return heap->compare(a->data, a->data_size, b->data, b->data_size) < 0;
+}
+
+/**
+ * @brief Move a node up until its parent has priority over it
+ * @param heap Pointer to the heap structure
+ * @param index Position of the node
+ * @note Internal use only
+ */
+static void sift_up(heap_t *heap, size_t index)
+{
+    node_t *node = heap->nodes[index];
+    size_t parent;
+
+    // Shift parents down instead of swapping, the node is written once at its final slot
+    while (index > 0)
+    {
+        parent = (index - 1) / HEAP_ARITY;
+        if (!node_before(heap, node, heap->nodes[parent]))
+            break;
+        heap->nodes[index] = heap->nodes[parent];
+        index = parent;
+    }
+    heap->nodes[index] = node;
+}
+
+/**
+ * @brief Move a node down until it has priority over all its children
+ * @param heap Pointer to the heap structure
+ * @param index Position of the node
+ * @note Internal use only
+ */
+static void sift_down(heap_t *heap, size_t index)
+{
+    node_t *node = heap->nodes[index];
+    size_t child, best, last;
+
+    while ((child = index * HEAP_ARITY + 1) < heap->size)
+    {
+        // Pick the child with the highest priority
+        best = child;
+        last = (child + HEAP_ARITY < heap->size) ? child + HEAP_ARITY : heap->size;
+        for (child++; child < last; child++)
+        {
+            if (node_before(heap, heap->nodes[child], heap->nodes[best]))
+                best = child;
+        }
+        if (!node_before(heap, heap->nodes[best], node))
+            break;
+        heap->nodes[index] = heap->nodes[best];
+        index = best;
+    }
+    heap->nodes[index] = node;
+}
+
+/**
+ * @brief Heap constructor
+ * @param compare Comparison function used to decide which of two items has priority
+ * @return An owning pointer that points to the new heap on success, NULL on error
+ */
+heap_t *heap_new(cmp_func_t compare)
+{
+    heap_t *new_heap;
+
+    // Reserve memory for the new heap structure
+    new_heap = malloc(sizeof *new_heap);
+    if (new_heap != NULL)
+    {
+        // Also reserve memory for the node array
+        new_heap->nodes = malloc(HEAP_INITIAL_CAPACITY * sizeof *new_heap->nodes);
+        if (new_heap->nodes == NULL)
+        {
+            free(new_heap);
+            return NULL;
+        }
+        new_heap->size = 0;
+        new_heap->capacity = HEAP_INITIAL_CAPACITY;
+        new_heap->compare = compare;
+    }
+
+    // Return a pointer to the new heap structure
+#ifdef DEBUG
+    printf("Created heap at %lx\n", (unsigned long int)new_heap);
+#endif
+    return new_heap;
+}
+
+/**
+ * @brief Heap destructor
+ * @param heap Pointer to the heap structure to be destroyed
+ */
+void heap_destroy(heap_t *heap)
+{
+    if (heap != NULL)
+    {
+        // Destroy all nodes before freeing the memory allocated to the heap structure
+        heap_clear(heap);
+        free(heap->nodes);
+        free(heap);
+#ifdef DEBUG
+        printf("Destroyed heap at %lx\n", (unsigned long int)heap);
+#endif
+    }
+}
+
+/**
+ * @brief Check if a heap contains no items
+ * @param heap Pointer to the heap structure
+ * @return 1 for empty, 0 otherwise
+ */
+int heap_empty(heap_t *heap)
+{
+    return (heap->size == 0) ? 1 : 0;
+}
+
+/**
+ * @brief Check the number of items a heap contains
+ * @param heap Pointer to the heap structure
+ * @return Number of items contained in the heap
+ */
+size_t heap_size(heap_t *heap)
+{
+    return heap->size;
+}
+
+/**
+ * @brief Insert an item into a heap
+ * @param heap Pointer to the heap structure
+ * @param data Data to be stored within the new item
+ * @param data_size Size of data in bytes
+ * @return 0 on success, -1 on error
+ */
+int heap_push(heap_t *heap, void *data, size_t data_size)
+{
+    node_t **nodes;
+    node_t *new_item;
+
+    // Grow the node array geometrically when it is full
+    if (heap->size == heap->capacity)
+    {
+        nodes = realloc(heap->nodes, 2 * heap->capacity * sizeof *nodes);
+        if (nodes == NULL)
+            return -1;
+        heap->nodes = nodes;
+        heap->capacity *= 2;
+    }
+
+    // Create a new node to encapsulate the data
+    new_item = node_new(data, data_size);
+    if (new_item == NULL)
+        return -1;
+
+    // Append the node as the last leaf and restore the heap property
+    heap->nodes[heap->size] = new_item;
+    sift_up(heap, heap->size++);
+
+    return 0;
+}
+
+/**
+ * @brief Extract the item with the highest priority from a heap
+ * @param heap Pointer to the heap structure
+ * @param dest Destination
+ */
+void heap_pop(heap_t *heap, void *dest)
+{
+    node_t *popped_node;
+
+    // The heap must exist and have at least one item to pop
+    if ((heap == NULL) || (heap->size == 0))
+        return;
+
+    // The last leaf replaces the root and sinks to its place
+    popped_node = heap->nodes[0];
+    heap->nodes[0] = heap->nodes[--heap->size];
+    if (heap->size > 0)
+        sift_down(heap, 0);
+
+    // Data from the popped node is copied into destination if provided
+    if (dest != NULL)
+    {
+        memcpy(dest, popped_node->data, popped_node->data_size);
+    }
+    // Finally, the popped node is destroyed
+    free(popped_node);
+}
+
+/**
+ * @brief Peek the item with the highest priority in a heap
+ * @param heap Pointer to the heap structure
+ * @param dest Destination
+ * @return 0 on success, -1 on error
+ */
+int heap_peek(heap_t *heap, void *dest)
+{
+    if ((heap != NULL) && (heap->size != 0) && (dest != NULL))
+    {
+        // Copy peeked data into its destination
+        memcpy(dest, heap->nodes[0]->data, heap->nodes[0]->data_size);
+        return 0;
+    }
+    return -1;
+}
+
+/**
+ * @brief Get a pointer to the item with the highest priority in a heap
+ * @param heap Pointer to the heap structure
+ * @return A pointer to the root node, NULL if the heap is empty
+ */
+node_t *heap_front(heap_t *heap)
+{
+    return ((heap != NULL) && (heap->size != 0)) ? heap->nodes[0] : NULL;
+}
+
+/**
+ * @brief Find the position of the item with the lowest priority in a heap
+ * @param heap Pointer to the heap structure
+ * @return Position of the node
+ * @note The heap must not be empty. Only leaves are scanned, but this is still O(n). Internal use only
+ */
+static size_t back_index(heap_t *heap)
+{
+    size_t back;
+    size_t i;
+
+    // The lowest priority item must be a leaf, and leaves follow the last parent
+    back = heap->size - 1;
+    for (i = (heap->size > 1) ? (heap->size - 2) / HEAP_ARITY + 1 : 0; i < heap->size; i++)
+    {
+        if (node_before(heap, heap->nodes[back], heap->nodes[i]))
+            back = i;
+    }
+
+    return back;
+}
+
+/**
+ * @brief Get a pointer to the item with the lowest priority in a heap
+ * @param heap Pointer to the heap structure
+ * @return A pointer to the node, NULL if the heap is empty
+ * @note Only leaves are scanned, but this is still O(n)
+ */
+node_t *heap_back(heap_t *heap)
+{
+    return ((heap != NULL) && (heap->size != 0)) ? heap->nodes[back_index(heap)] : NULL;
+}
+
+/**
+ * @brief Extract the item with the lowest priority from a heap
+ * @param heap Pointer to the heap structure
+ * @param dest Destination
+ * @note The item is found by scanning the leaves, O(n). Use a min-max heap when both ends are needed
+ */
+void heap_pop_back(heap_t *heap, void *dest)
+{
+    node_t *popped_node;
+    size_t index;
+
+    // The heap must exist and have at least one item to pop
+    if ((heap == NULL) || (heap->size == 0))
+        return;
+
+    // The last leaf replaces the popped leaf and climbs to its place
+    index = back_index(heap);
+    popped_node = heap->nodes[index];
+    heap->nodes[index] = heap->nodes[--heap->size];
+    if (index < heap->size)
+        sift_up(heap, index);
+
+    // Data from the popped node is copied into destination if provided
+    if (dest != NULL)
+    {
+        memcpy(dest, popped_node->data, popped_node->data_size);
+    }
+    // Finally, the popped node is destroyed
+    free(popped_node);
+}
+
+/**
+ * @brief Clear a heap's contents
+ * @param heap Pointer to the heap structure
+ */
+void heap_clear(heap_t *heap)
+{
+#ifdef DEBUG
+    printf("Clearing heap...\n");
+#endif
+    while (heap->size > 0)
+    {
+        free(heap->nodes[--heap->size]);
+    }
+}
+
+/**
+ * @brief Restore the heap property after the comparison function changes
+ * @param heap Pointer to the heap structure
+ * @param compare New comparison function
+ * @note Uses bottom-up heap construction, O(n)
+ */
+void heap_rebuild(heap_t *heap, cmp_func_t compare)
+{
+    size_t i;
+
+    heap->compare = compare;
+    if (heap->size < 2)
+        return;
+
+    // Sift every parent down, starting from the last one
+    i = (heap->size - 2) / HEAP_ARITY + 1;
+    while (i-- > 0)
+    {
+        sift_down(heap, i);
+    }
+}
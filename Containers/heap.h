@@ -0,0 +1,27 @@
+#ifndef _HEAP_H
+#define _HEAP_H
+
+#include "sorted_list.h"
+
+typedef struct heap
+{
+    node_t **nodes;
+    size_t size;
+    size_t capacity;
+    cmp_func_t compare;
+} heap_t;
+
+heap_t *heap_new(cmp_func_t compare);
+void heap_destroy(heap_t *heap);
+int heap_empty(heap_t *heap);
+size_t heap_size(heap_t *heap);
+int heap_push(heap_t *heap, void *data, size_t data_size);
+void heap_pop(heap_t *heap, void *dest);
+void heap_pop_back(heap_t *heap, void *dest);
+int heap_peek(heap_t *heap, void *dest);
+node_t *heap_front(heap_t *heap);
+node_t *heap_back(heap_t *heap);
+void heap_clear(heap_t *heap);
+void heap_rebuild(heap_t *heap, cmp_func_t compare);
+
+#endif
@@ -2,36 +2,30 @@
 #include <string.h>
 #ifdef DEBUG
 #include <stdio.h>
+#include <assert.h>
 #endif
 
 /**
  * @brief Node constructor
- * @param data Data to be stored within the new node
+ * @param pool Node pool to take the node from, NULL to use malloc
  * @param data_size Size of the datatype stored within the new node in bytes
- * @return An owning pointer that points to the new node
+ * @return An owning pointer that points to the new node, its data is left for the caller to fill
  * @note Internal use only
  */
-static node_t *node_new(void *data, size_t data_size)
+static node_t *node_new(node_pool_t *pool, size_t data_size)
 {
     node_t *new_node;
 
     // Empty list items aren't supported
-    if ((data == NULL) || (data_size == 0))
+    if (data_size == 0)
         return NULL;
 
-    // Reserve memory for the new node
-    new_node = malloc(sizeof *new_node);
+    // Reserve memory for the new node and its encapsulated data in a single block
+    new_node = node_pool_alloc(pool, sizeof *new_node + data_size);
     if (new_node != NULL)
     {
-        // Also reserve memory for the encapsulated data
-        new_node->data = malloc(data_size);
-        if (new_node->data == NULL)
-        {
-            free(new_node);
-            return NULL;
-        }
-        // Initialize the structure
-        memcpy(new_node->data, data, data_size);
+        // Initialize the structure, data is stored inline right after the links
+        new_node->data = new_node->payload;
         new_node->data_size = data_size;
         new_node->previous = NULL;
         new_node->next = NULL;
@@ -44,24 +38,216 @@ static node_t *node_new(void *data, size_t data_size)
     return new_node;
 }
 
+/**
+ * @brief Node constructor that adopts a heap buffer instead of copying it
+ * @param pool Node pool to take the node from, NULL to use malloc
+ * @param data Buffer obtained from malloc, owned by the node on success
+ * @param data_size Size of the buffer in bytes
+ * @return An owning pointer that points to the new node
+ * @note Internal use only
+ */
+static node_t *node_adopt(node_pool_t *pool, void *data, size_t data_size)
+{
+    node_t *new_node;
+
+    // Empty list items aren't supported
+    if ((data == NULL) || (data_size == 0))
+        return NULL;
+
+    // Only the links are reserved, the node points to the adopted buffer
+    new_node = node_pool_alloc(pool, sizeof *new_node);
+    if (new_node != NULL)
+    {
+        new_node->data = data;
+        new_node->data_size = data_size;
+        new_node->previous = NULL;
+        new_node->next = NULL;
+    }
+
+#ifdef DEBUG
+    printf("Created node at %lx adopting %lx\n", (unsigned long int)new_node, (unsigned long int)data);
+#endif
+    return new_node;
+}
+
+/**
+ * @brief Check if a node's data lives in a separate buffer it owns
+ * @param node Pointer to the node structure
+ * @return 1 if the data was adopted, 0 if it is stored inline
+ * @note Internal use only
+ */
+static int node_owns_buffer(node_t *node)
+{
+    return (node->data != (void *)node->payload) ? 1 : 0;
+}
+
 /**
  * @brief Node destructor
+ * @param pool Node pool the node was taken from, NULL if it came from malloc
  * @param node Pointer to the node structure to be destroyed
  * @note Internal use only
  */
-static void node_destroy(node_t *node)
+static void node_destroy(node_pool_t *pool, node_t *node)
 {
     if (node != NULL)
     {
-        // Free memory allocated to the node structure and its internal data
-        free(node->data);
-        free(node);
+        if (node_owns_buffer(node))
+        {
+            // Adopted buffers are freed along with the links
+            free(node->data);
+            node_pool_free(pool, node, sizeof *node);
+        }
+        else
+        {
+            // Data is stored inline, so a single block holds the whole node
+            node_pool_free(pool, node, sizeof *node + node->data_size);
+        }
 #ifdef DEBUG
         printf("Destroyed node at %lx\n", (unsigned long int)node);
 #endif
     }
 }
 
+/**
+ * @brief Get a heap buffer holding a node's data, without touching the node
+ * @param node Pointer to the node structure
+ * @return The adopted buffer or a copy of the inline data, NULL if the copy could not be allocated
+ * @note Internal use only. Called before unlinking so a failed allocation leaves the list intact
+ */
+static void *node_take_data(node_t *node)
+{
+    void *data;
+
+    // Adopted buffers are handed back as they are
+    if (node_owns_buffer(node))
+        return node->data;
+
+    // Inline data has to move into a buffer of its own
+    data = malloc(node->data_size);
+    if (data != NULL)
+        memcpy(data, node->data, node->data_size);
+    return data;
+}
+
+/**
+ * @brief Destroy a node whose data was taken by node_take_data()
+ * @param pool Node pool the node was taken from, NULL if it came from malloc
+ * @param node Pointer to the unlinked node structure
+ * @param data_size Destination for the size of the data in bytes, may be NULL
+ * @note Internal use only
+ */
+static void node_release(node_pool_t *pool, node_t *node, size_t *data_size)
+{
+    if (data_size != NULL)
+        *data_size = node->data_size;
+    if (node_owns_buffer(node))
+        node_pool_free(pool, node, sizeof *node);
+    else
+        node_destroy(pool, node);
+}
+
+/**
+ * @brief Link a node at the front of a list
+ * @param list Pointer to the list structure
+ * @param node Pointer to the unlinked node
+ * @note Internal use only
+ */
+static void link_front(list_t *list, node_t *node)
+{
+    // If the list was empty, the new node becomes head and tail
+    if (list->head == NULL)
+    {
+        list->head = node;
+        list->tail = node;
+    }
+    else
+    {
+        // Otherwise, the new node becomes head
+        node->next = list->head;
+        list->head->previous = node;
+        list->head = node;
+    }
+    list->size++;
+}
+
+/**
+ * @brief Link a node at the back of a list
+ * @param list Pointer to the list structure
+ * @param node Pointer to the unlinked node
+ * @note Internal use only
+ */
+static void link_back(list_t *list, node_t *node)
+{
+    // If the list was empty, the new node becomes head and tail
+    node->previous = list->tail;
+    if (node->previous == NULL)
+    {
+        list->head = node;
+        list->tail = node;
+    }
+    else
+    {
+        // Otherwise, the new node becomes tail
+        list->tail->next = node;
+        list->tail = node;
+    }
+    list->size++;
+}
+
+/**
+ * @brief Unlink the node at the front of a non-empty list
+ * @param list Pointer to the list structure
+ * @return A pointer to the unlinked node
+ * @note Internal use only
+ */
+static node_t *unlink_front(list_t *list)
+{
+    node_t *node;
+
+    // The next node on the list becomes the new head
+    node = list->head;
+    list->head = node->next;
+    if (list->head)
+    {
+        list->head->previous = NULL;
+    }
+    else
+    {
+        // If the list is now empty, tail must also be NULL
+        list->tail = NULL;
+    }
+    list->size--;
+
+    return node;
+}
+
+/**
+ * @brief Unlink the node at the back of a non-empty list
+ * @param list Pointer to the list structure
+ * @return A pointer to the unlinked node
+ * @note Internal use only
+ */
+static node_t *unlink_back(list_t *list)
+{
+    node_t *node;
+
+    // The second to last node on the list becomes the new tail
+    node = list->tail;
+    list->tail = node->previous;
+    if (list->tail != NULL)
+    {
+        list->tail->next = NULL;
+    }
+    else
+    {
+        // If the list is now empty, head must also be NULL
+        list->head = NULL;
+    }
+    list->size--;
+
+    return node;
+}
+
 /**
  * @brief List constructor
  * @return An owning pointer that points to the new list
@@ -77,6 +263,8 @@ list_t *list_new()
         // Initialize the structure
         new_list->head = NULL;
         new_list->tail = NULL;
+        new_list->size = 0;
+        new_list->pool = NULL;
     }
 
     // Return a pointer to the new list structure
@@ -86,6 +274,53 @@ list_t *list_new()
     return new_list;
 }
 
+/**
+ * @brief Pooled list constructor
+ * @param data_size Size of the datatype the list is expected to store in bytes
+ * @param nodes_per_slab Number of nodes reserved at once when the pool runs dry, 0 for a default
+ * @return An owning pointer that points to the new list
+ * @note Nodes are recycled through a pool owned by the list, larger items fall back to malloc
+ */
+list_t *list_new_pooled(size_t data_size, size_t nodes_per_slab)
+{
+    list_t *new_list;
+
+    new_list = list_new();
+    if (new_list != NULL)
+    {
+        // Also reserve a pool whose blocks fit a node along with its inline data
+        new_list->pool = node_pool_new(sizeof(node_t) + data_size, nodes_per_slab);
+        if (new_list->pool == NULL)
+        {
+            free(new_list);
+            new_list = NULL;
+        }
+    }
+
+    return new_list;
+}
+
+/**
+ * @brief Constructor for a list sharing another list's node pool
+ * @param other Pointer to the list structure whose pool is shared
+ * @return An owning pointer that points to the new list, NULL on error
+ * @note Lists sharing a pool can splice and split their nodes in O(1). The pool is freed along with
+ *       the last list using it
+ */
+list_t *list_new_shared(list_t *other)
+{
+    list_t *new_list;
+
+    if (other == NULL)
+        return NULL;
+
+    new_list = list_new();
+    if (new_list != NULL)
+        new_list->pool = node_pool_share(other->pool);
+
+    return new_list;
+}
+
 /**
  * @brief List destructor
  * @param list Pointer to the list structure to be destroyed
@@ -99,6 +334,7 @@ void list_destroy(list_t *list)
     printf("Destroying list...\n");
 #endif
         list_clear(list);
+        node_pool_destroy(list->pool);
         free(list);
 #ifdef DEBUG
     printf("Destroyed list at %lx\n", (unsigned long int)list);
@@ -124,18 +360,21 @@ int list_empty(list_t *list)
  */
 size_t list_size(list_t *list)
 {
+#ifdef DEBUG
     size_t ret = 0;
     node_t *iterator;
-    
-    // Traverse the list counting the nodes
+
+    // Validate the item counter against a full traversal
     iterator = list->head;
     while (iterator != NULL)
     {
         ret++;
         iterator = iterator->next;
     }
-
-    return ret;
+    assert(ret == list->size);
+#endif
+    // Every mutating operation keeps the item counter up to date
+    return list->size;
 }
 
 /**
@@ -159,28 +398,57 @@ int list_add(list_t *list, void *data, size_t data_size)
  * @return 0 on success, -1 on error
  */
 int list_push_front(list_t *list, void *data, size_t data_size)
+{
+    void *dest;
+
+    if (data == NULL)
+        return -1;
+
+    // Reserve the new item in place, then fill it
+    dest = list_emplace_front(list, data_size);
+    if (dest == NULL)
+        return -1;
+    memcpy(dest, data, data_size);
+
+    return 0;
+}
+
+/**
+ * @brief Insert an uninitialized item at the front of a list
+ * @param list Pointer to the list structure
+ * @param data_size Size of the new item in bytes
+ * @return A pointer to the new item's data for the caller to fill, NULL on error
+ */
+void *list_emplace_front(list_t *list, size_t data_size)
 {
     node_t *new_item;
     
     // Create a new node to encapsulate the data
-    new_item = node_new(data, data_size);
+    new_item = node_new(list->pool, data_size);
     if (new_item == NULL)
-        return -1;
-    
-    // If the list was empty, the new node becomes head and tail
-    if (list->head == NULL)
-    {
-        list->head = new_item;
-        list->tail = new_item;
-    }
-    else
-    {
-        // Otherwise, the new node becomes head
-        new_item->next = list->head;
-        list->head->previous = new_item;
-        list->head = new_item;
-    }
+        return NULL;
+    link_front(list, new_item);
     
+    return new_item->data;
+}
+
+/**
+ * @brief Insert a heap buffer at the front of a list without copying it
+ * @param list Pointer to the list structure
+ * @param data Buffer obtained from malloc, owned by the list on success
+ * @param data_size Size of the buffer in bytes
+ * @return 0 on success, -1 on error, in which case the caller keeps ownership of data
+ */
+int list_push_front_owned(list_t *list, void *data, size_t data_size)
+{
+    node_t *new_item;
+
+    // Create a new node around the buffer
+    new_item = node_adopt(list->pool, data, data_size);
+    if (new_item == NULL)
+        return -1;
+    link_front(list, new_item);
+
     return 0;
 }
 
@@ -196,19 +464,7 @@ void list_pop_front(list_t *list, void *dest)
     // The list must exist and have at least one item to pop
     if ((list == NULL) || (list->tail == NULL))
         return;
-
-    // The next node on the list becomes the new head
-    popped_node = list->head;
-    list->head = popped_node->next;
-    if (list->head)
-    {
-        list->head->previous = NULL;
-    }
-    else
-    {
-        // If the list is now empty, tail must also be NULL
-        list->tail = NULL;
-    }
+    popped_node = unlink_front(list);
 
     // Data from the popped node is copied into destination if provided
     if (dest != NULL)
@@ -216,7 +472,29 @@ void list_pop_front(list_t *list, void *dest)
         memcpy(dest, popped_node->data, popped_node->data_size);
     }
     // Finally, the popped node is destroyed
-    node_destroy(popped_node);
+    node_destroy(list->pool, popped_node);
+}
+
+/**
+ * @brief Extract the item at the front of a list as a heap buffer
+ * @param list Pointer to the list structure
+ * @param data_size Destination for the size of the item in bytes, may be NULL
+ * @return A buffer holding the item that the caller must free, NULL if the list is empty or on error
+ * @note Buffers adopted by a push_owned call are returned without copying
+ */
+void *list_pop_front_owned(list_t *list, size_t *data_size)
+{
+    void *data;
+
+    // The list must exist and have at least one item to pop
+    if ((list == NULL) || (list->tail == NULL))
+        return NULL;
+
+    data = node_take_data(list->head);
+    if (data == NULL)
+        return NULL;
+    node_release(list->pool, unlink_front(list), data_size);
+    return data;
 }
 
 /**
@@ -236,6 +514,17 @@ int list_peek_front(list_t *list, void *dest)
     return -1;
 }
 
+/**
+ * @brief Get a pointer to the item at the front of a list
+ * @param list Pointer to the list structure
+ * @return A pointer to the item's data, NULL if the list is empty
+ * @note The pointer is valid until the item is removed
+ */
+void *list_front_ptr(list_t *list)
+{
+    return ((list != NULL) && (list->head != NULL)) ? list->head->data : NULL;
+}
+
 /**
  * @brief Insert an item at the back of a list
  * @param list Pointer to the list structure
@@ -244,27 +533,56 @@ int list_peek_front(list_t *list, void *dest)
  * @return 0 on success, -1 on error
  */
 int list_push_back(list_t *list, void *data, size_t data_size)
+{
+    void *dest;
+
+    if (data == NULL)
+        return -1;
+
+    // Reserve the new item in place, then fill it
+    dest = list_emplace_back(list, data_size);
+    if (dest == NULL)
+        return -1;
+    memcpy(dest, data, data_size);
+
+    return 0;
+}
+
+/**
+ * @brief Insert an uninitialized item at the back of a list
+ * @param list Pointer to the list structure
+ * @param data_size Size of the new item in bytes
+ * @return A pointer to the new item's data for the caller to fill, NULL on error
+ */
+void *list_emplace_back(list_t *list, size_t data_size)
 {
     node_t *new_item;
     
     // Create a new node to encapsulate the data
-    new_item = node_new(data, data_size);
+    new_item = node_new(list->pool, data_size);
     if (new_item == NULL)
-        return -1;
+        return NULL;
+    link_back(list, new_item);
 
-    // If the list was empty, the new node becomes head and tail
-    new_item->previous = list->tail;
-    if (new_item->previous == NULL)
-    {
-        list->head = new_item;
-        list->tail = new_item;
-    }
-    else
-    {
-        // Otherwise, the new node becomes tail
-        list->tail->next = new_item;
-        list->tail = new_item;
-    }
+    return new_item->data;
+}
+
+/**
+ * @brief Insert a heap buffer at the back of a list without copying it
+ * @param list Pointer to the list structure
+ * @param data Buffer obtained from malloc, owned by the list on success
+ * @param data_size Size of the buffer in bytes
+ * @return 0 on success, -1 on error, in which case the caller keeps ownership of data
+ */
+int list_push_back_owned(list_t *list, void *data, size_t data_size)
+{
+    node_t *new_item;
+
+    // Create a new node around the buffer
+    new_item = node_adopt(list->pool, data, data_size);
+    if (new_item == NULL)
+        return -1;
+    link_back(list, new_item);
 
     return 0;
 }
@@ -281,19 +599,7 @@ void list_pop_back(list_t *list, void *dest)
     // The list must exist and have at least one item to pop
     if ((list == NULL) || (list->tail == NULL))
         return;
-
-    // The second to last node on the list becomes the new tail
-    popped_node = list->tail;
-    list->tail = popped_node->previous;
-    if (list->tail != NULL)
-    {
-        list->tail->next = NULL;
-    }
-    else
-    {
-        // If the list is now empty, head must also be NULL
-        list->head = NULL;
-    }
+    popped_node = unlink_back(list);
 
     // Data from the popped node is copied into destination if provided
     if (dest != NULL)
@@ -301,7 +607,29 @@ void list_pop_back(list_t *list, void *dest)
         memcpy(dest, popped_node->data, popped_node->data_size);
     }
     // Finally, the popped node is destroyed
-    node_destroy(popped_node);
+    node_destroy(list->pool, popped_node);
+}
+
+/**
+ * @brief Extract the item at the back of a list as a heap buffer
+ * @param list Pointer to the list structure
+ * @param data_size Destination for the size of the item in bytes, may be NULL
+ * @return A buffer holding the item that the caller must free, NULL if the list is empty or on error
+ * @note Buffers adopted by a push_owned call are returned without copying
+ */
+void *list_pop_back_owned(list_t *list, size_t *data_size)
+{
+    void *data;
+
+    // The list must exist and have at least one item to pop
+    if ((list == NULL) || (list->tail == NULL))
+        return NULL;
+
+    data = node_take_data(list->tail);
+    if (data == NULL)
+        return NULL;
+    node_release(list->pool, unlink_back(list), data_size);
+    return data;
 }
 
 /**
@@ -321,6 +649,130 @@ int list_peek_back(list_t *list, void *dest)
     return -1;
 }
 
+/**
+ * @brief Get a pointer to the item at the back of a list
+ * @param list Pointer to the list structure
+ * @return A pointer to the item's data, NULL if the list is empty
+ * @note The pointer is valid until the item is removed
+ */
+void *list_back_ptr(list_t *list)
+{
+    return ((list != NULL) && (list->tail != NULL)) ? list->tail->data : NULL;
+}
+
+/**
+ * @brief Move every item of a list into another one before a given position
+ * @param list Pointer to the destination list structure
+ * @param position Node of the destination list to insert before, NULL to append
+ * @param other Pointer to the source list structure, left empty
+ * @return 0 on success, -1 on error
+ * @note Nodes are relinked without touching their data, O(1). Both lists must share the same
+ *       node pool, see list_new_shared(), or have none, as nodes are returned to their list's pool.
+ */
+int list_splice(list_t *list, node_t *position, list_t *other)
+{
+    if ((list == NULL) || (other == NULL) || (list == other) || (list->pool != other->pool))
+        return -1;
+    if (other->head == NULL)
+        return 0;
+
+    if (position == NULL)
+    {
+        // Append after the current tail
+        other->head->previous = list->tail;
+        if (list->tail != NULL)
+            list->tail->next = other->head;
+        else
+            list->head = other->head;
+        list->tail = other->tail;
+    }
+    else
+    {
+        // Link the source run between the position and the node before it
+        other->head->previous = position->previous;
+        if (position->previous != NULL)
+            position->previous->next = other->head;
+        else
+            list->head = other->head;
+        other->tail->next = position;
+        position->previous = other->tail;
+    }
+    list->size += other->size;
+
+    // The source list no longer owns any node
+    other->head = NULL;
+    other->tail = NULL;
+    other->size = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Move every item of a list to the back of another one
+ * @param list Pointer to the destination list structure
+ * @param other Pointer to the source list structure, left empty
+ * @return 0 on success, -1 on error
+ * @note O(1), see list_splice()
+ */
+int list_concat(list_t *list, list_t *other)
+{
+    return list_splice(list, NULL, other);
+}
+
+/**
+ * @brief Move the items of a list from a given index onwards to the back of another one
+ * @param list Pointer to the source list structure, keeps its first index items
+ * @param index Position of the first item to be moved
+ * @param dest Pointer to the destination list structure
+ * @return 0 on success, -1 on error
+ * @note The split point is found from the nearest end, O(min(index, size - index)).
+ *       Both lists must share the same node pool, or have none.
+ */
+int list_split_at(list_t *list, size_t index, list_t *dest)
+{
+    node_t *first, *last;
+    size_t i;
+
+    if ((list == NULL) || (dest == NULL) || (list == dest) || (list->pool != dest->pool) || (index > list->size))
+        return -1;
+    if (index == list->size)
+        return 0;
+
+    // Find the first node to be moved, walking from whichever end is closer
+    if (index <= list->size / 2)
+    {
+        first = list->head;
+        for (i = 0; i < index; i++)
+            first = first->next;
+    }
+    else
+    {
+        first = list->tail;
+        for (i = list->size - 1; i > index; i--)
+            first = first->previous;
+    }
+
+    // Detach the run from that node to the tail, the node before it becomes the source's tail
+    last = list->tail;
+    list->tail = first->previous;
+    if (list->tail != NULL)
+        list->tail->next = NULL;
+    else
+        list->head = NULL;
+
+    // Append the run to the destination
+    first->previous = dest->tail;
+    if (dest->tail != NULL)
+        dest->tail->next = first;
+    else
+        dest->head = first;
+    dest->tail = last;
+    dest->size += list->size - index;
+    list->size = index;
+
+    return 0;
+}
+
 /**
  * @brief Clear a list's contents
  * @param list Pointer to the list structure
@@ -337,4 +789,24 @@ void list_clear(list_t *list)
     }
     list->head = NULL;
     list->tail = NULL;
+    list->size = 0;
+
+    // Every node is back in the pool, so its slabs can be released as a whole
+    if (list->pool != NULL)
+        node_pool_release(list->pool);
+}
+
+/**
+ * @brief Get the allocation counters of a pooled list
+ * @param list Pointer to the list structure
+ * @param dest Destination
+ * @return 0 on success, -1 if the list has no pool
+ */
+int list_pool_stats(list_t *list, node_pool_stats_t *dest)
+{
+    if ((list == NULL) || (list->pool == NULL) || (dest == NULL))
+        return -1;
+
+    *dest = list->pool->stats;
+    return 0;
 }
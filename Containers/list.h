@@ -2,6 +2,8 @@
 #define _LIST_H
 
 #include <stdlib.h>
+#include <stddef.h>
+#include "node_pool.h"
 
 typedef struct node node_t;
 
@@ -11,25 +13,43 @@ struct node
     size_t data_size;
     node_t *next;
     node_t *previous;
+    // Inline data starts at an address suitable for any type, like a malloc block
+    _Alignas(max_align_t) unsigned char payload[];
 };
 
 typedef struct list
 {
     node_t *head;
     node_t *tail;
+    size_t size;
+    node_pool_t *pool;
 } list_t;
 
 list_t *list_new();
+list_t *list_new_pooled(size_t data_size, size_t nodes_per_slab);
+list_t *list_new_shared(list_t *other);
 void list_destroy(list_t *list);
 int list_empty(list_t *list);
 size_t list_size(list_t *list);
 int list_add(list_t *list, void *data, size_t data_size);
 int list_push_front(list_t *list, void *data, size_t data_size);
+void *list_emplace_front(list_t *list, size_t data_size);
+int list_push_front_owned(list_t *list, void *data, size_t data_size);
 void list_pop_front(list_t *list, void *dest);
+void *list_pop_front_owned(list_t *list, size_t *data_size);
 int list_peek_front(list_t *list, void *dest);
+void *list_front_ptr(list_t *list);
 int list_push_back(list_t *list, void *data, size_t data_size);
+void *list_emplace_back(list_t *list, size_t data_size);
+int list_push_back_owned(list_t *list, void *data, size_t data_size);
 void list_pop_back(list_t *list, void *dest);
+void *list_pop_back_owned(list_t *list, size_t *data_size);
 int list_peek_back(list_t *list, void *dest);
+void *list_back_ptr(list_t *list);
+int list_splice(list_t *list, node_t *position, list_t *other);
+int list_concat(list_t *list, list_t *other);
+int list_split_at(list_t *list, size_t index, list_t *dest);
 void list_clear(list_t *list);
+int list_pool_stats(list_t *list, node_pool_stats_t *dest);
 
 #endif
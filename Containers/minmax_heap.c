@@ -0,0 +1,433 @@
+#include "minmax_heap.h"
+#include <string.h>
+#ifdef DEBUG
+#include <stdio.h>
+#endif
+
+#define MINMAX_HEAP_INITIAL_CAPACITY 16
+
+/**
+ * @brief Node constructor
+ * @param data Data to be stored within the new node
+ * @param data_size Size of the datatype stored within the new node in bytes
+ * @return An owning pointer that points to the new node
+ * @note Internal use only
+ */
+static node_t *node_new(void *data, size_t data_size)
+{
+    node_t *new_node;
+
+    // Empty heap items aren't supported
+    if ((data == NULL) || (data_size == 0))
+        return NULL;
+
+    // Reserve memory for the new node and its encapsulated data in a single block
+    new_node = malloc(sizeof *new_node + data_size);
+    if (new_node != NULL)
+    {
+        // Initialize the structure, heap nodes are never chained
+        new_node->data = new_node->payload;
+        memcpy(new_node->data, data, data_size);
+        new_node->data_size = data_size;
+        new_node->next = NULL;
+    }
+
+    return new_node;
+}
+
+/**
+ * @brief Check if a position lies on a front level of the heap
+ * @param index Position of the node
+ * @return Non-zero if the node must have priority over all its descendants,
+ *         zero if all its descendants must have priority over it
+ * @note Levels alternate, starting with a front level at the root. Internal use only
+ */
+static int on_front_level(size_t index)
+{
+    int level = 0;
+
+    // The level of a node is the position of the highest set bit of index + 1
+    for (index++; index > 1; index >>= 1)
+    {
+        level++;
+    }
+
+    return (level % 2) == 0;
+}
+
+/**
+ * @brief Check if a node must be placed above another one on a given kind of level
+ * @param heap Pointer to the heap structure
+ * @param a Position of the first node
+ * @param b Position of the second node
+ * @param front Non-zero to check against front levels, zero for back levels
+ * @return Non-zero if a must be placed above b
+ * @note Internal use only
+ */
+static int node_above(minmax_heap_t *heap, size_t a, size_t b, int front)
+{
+    node_t *first = heap->nodes[a];
+    node_t *second = heap->nodes[b];
+
+    // Front levels hold the items with the highest priority, back levels the ones with the lowest
+    if (front)
+        return heap->compare(first->data, first->data_size, second->data, second->data_size) < 0;
+    return heap->compare(second->data, second->data_size, first->data, first->data_size) < 0;
+}
+
+/**
+ * @brief Exchange two nodes of a heap
+ * @param heap Pointer to the heap structure
+ * @param a Position of the first node
+ * @param b Position of the second node
+ * @note Internal use only
+ */
+static void node_swap(minmax_heap_t *heap, size_t a, size_t b)
+{
+    node_t *temp = heap->nodes[a];
+
+    heap->nodes[a] = heap->nodes[b];
+    heap->nodes[b] = temp;
+}
+
+/**
+ * @brief Move a node up until the min-max heap property holds again
+ * @param heap Pointer to the heap structure
+ * @param index Position of the node
+ * @note Internal use only
+ */
+static void bubble_up(minmax_heap_t *heap, size_t index)
+{
+    int front;
+    size_t parent;
+    size_t grandparent;
+
+    if (index == 0)
+        return;
+
+    // A node that belongs to the opposite kind of level is exchanged with its parent first
+    front = on_front_level(index);
+    parent = (index - 1) / 2;
+    if (node_above(heap, parent, index, front))
+    {
+        node_swap(heap, index, parent);
+        index = parent;
+        front = !front;
+    }
+
+    // Then it climbs through the levels of its own kind, which are two apart
+    while (index > 2)
+    {
+        grandparent = ((index - 1) / 2 - 1) / 2;
+        if (!node_above(heap, index, grandparent, front))
+            break;
+        node_swap(heap, index, grandparent);
+        index = grandparent;
+    }
+}
+
+/**
+ * @brief Move a node down until the min-max heap property holds again
+ * @param heap Pointer to the heap structure
+ * @param index Position of the node
+ * @note Internal use only
+ */
+static void trickle_down(minmax_heap_t *heap, size_t index)
+{
+    int front = on_front_level(index);
+    size_t child, best, last, parent;
+
+    while ((child = 2 * index + 1) < heap->size)
+    {
+        // Pick the best node among the children and grandchildren
+        best = child;
+        if ((child + 1 < heap->size) && node_above(heap, child + 1, best, front))
+            best = child + 1;
+        last = (4 * index + 7 < heap->size) ? 4 * index + 7 : heap->size;
+        for (child = 4 * index + 3; child < last; child++)
+        {
+            if (node_above(heap, child, best, front))
+                best = child;
+        }
+        if (!node_above(heap, best, index, front))
+            break;
+        node_swap(heap, index, best);
+
+        // A child is a leaf of the subtree, nothing else to fix below it
+        if (best <= 2 * index + 2)
+            break;
+
+        // The node moved two levels down and may belong below its new parent instead
+        parent = (best - 1) / 2;
+        if (node_above(heap, parent, best, front))
+            node_swap(heap, best, parent);
+        index = best;
+    }
+}
+
+/**
+ * @brief Find the position of the item with the lowest priority in a heap
+ * @param heap Pointer to the heap structure
+ * @return Position of the node
+ * @note The heap must not be empty. Internal use only
+ */
+static size_t back_index(minmax_heap_t *heap)
+{
+    // The lowest priority item is the root or one of its children
+    if (heap->size < 3)
+        return heap->size - 1;
+    return node_above(heap, 1, 2, 0) ? 1 : 2;
+}
+
+/**
+ * @brief Remove the node at a given position from a heap
+ * @param heap Pointer to the heap structure
+ * @param index Position of the node
+ * @param dest Destination
+ * @note Internal use only
+ */
+static void remove_at(minmax_heap_t *heap, size_t index, void *dest)
+{
+    node_t *popped_node;
+
+    // The last leaf replaces the removed node and sinks to its place
+    popped_node = heap->nodes[index];
+    heap->nodes[index] = heap->nodes[--heap->size];
+    if (index < heap->size)
+        trickle_down(heap, index);
+
+    // Data from the popped node is copied into destination if provided
+    if (dest != NULL)
+    {
+        memcpy(dest, popped_node->data, popped_node->data_size);
+    }
+    // Finally, the popped node is destroyed
+    free(popped_node);
+}
+
+/**
+ * @brief Min-max heap constructor
+ * @param compare Comparison function used to decide which of two items has priority
+ * @return An owning pointer that points to the new heap on success, NULL on error
+ */
+minmax_heap_t *minmax_heap_new(cmp_func_t compare)
+{
+    minmax_heap_t *new_heap;
+
+    // Reserve memory for the new heap structure
+    new_heap = malloc(sizeof *new_heap);
+    if (new_heap != NULL)
+    {
+        // Also reserve memory for the node array
+        new_heap->nodes = malloc(MINMAX_HEAP_INITIAL_CAPACITY * sizeof *new_heap->nodes);
+        if (new_heap->nodes == NULL)
+        {
+            free(new_heap);
+            return NULL;
+        }
+        new_heap->size = 0;
+        new_heap->capacity = MINMAX_HEAP_INITIAL_CAPACITY;
+        new_heap->compare = compare;
+    }
+
+    // Return a pointer to the new heap structure
+#ifdef DEBUG
+    printf("Created min-max heap at %lx\n", (unsigned long int)new_heap);
+#endif
+    return new_heap;
+}
+
+/**
+ * @brief Min-max heap destructor
+ * @param heap Pointer to the heap structure to be destroyed
+ */
+void minmax_heap_destroy(minmax_heap_t *heap)
+{
+    if (heap != NULL)
+    {
+        // Destroy all nodes before freeing the memory allocated to the heap structure
+        minmax_heap_clear(heap);
+        free(heap->nodes);
+        free(heap);
+#ifdef DEBUG
+        printf("Destroyed min-max heap at %lx\n", (unsigned long int)heap);
+#endif
+    }
+}
+
+/**
+ * @brief Check if a heap contains no items
+ * @param heap Pointer to the heap structure
+ * @return 1 for empty, 0 otherwise
+ */
+int minmax_heap_empty(minmax_heap_t *heap)
+{
+    return (heap->size == 0) ? 1 : 0;
+}
+
+/**
+ * @brief Check the number of items a heap contains
+ * @param heap Pointer to the heap structure
+ * @return Number of items contained in the heap
+ */
+size_t minmax_heap_size(minmax_heap_t *heap)
+{
+    return heap->size;
+}
+
+/**
+ * @brief Insert an item into a heap
+ * @param heap Pointer to the heap structure
+ * @param data Data to be stored within the new item
+ * @param data_size Size of data in bytes
+ * @return 0 on success, -1 on error
+ */
+int minmax_heap_push(minmax_heap_t *heap, void *data, size_t data_size)
+{
+    node_t **nodes;
+    node_t *new_item;
+
+    // Grow the node array geometrically when it is full
+    if (heap->size == heap->capacity)
+    {
+        nodes = realloc(heap->nodes, 2 * heap->capacity * sizeof *nodes);
+        if (nodes == NULL)
+            return -1;
+        heap->nodes = nodes;
+        heap->capacity *= 2;
+    }
+
+    // Create a new node to encapsulate the data
+    new_item = node_new(data, data_size);
+    if (new_item == NULL)
+        return -1;
+
+    // Append the node as the last leaf and restore the heap property
+    heap->nodes[heap->size] = new_item;
+    bubble_up(heap, heap->size++);
+
+    return 0;
+}
+
+/**
+ * @brief Extract the item with the highest priority from a heap
+ * @param heap Pointer to the heap structure
+ * @param dest Destination
+ */
+void minmax_heap_pop_front(minmax_heap_t *heap, void *dest)
+{
+    // The heap must exist and have at least one item to pop
+    if ((heap == NULL) || (heap->size == 0))
+        return;
+
+    remove_at(heap, 0, dest);
+}
+
+/**
+ * @brief Extract the item with the lowest priority from a heap
+ * @param heap Pointer to the heap structure
+ * @param dest Destination
+ */
+void minmax_heap_pop_back(minmax_heap_t *heap, void *dest)
+{
+    // The heap must exist and have at least one item to pop
+    if ((heap == NULL) || (heap->size == 0))
+        return;
+
+    remove_at(heap, back_index(heap), dest);
+}
+
+/**
+ * @brief Peek the item with the highest priority in a heap
+ * @param heap Pointer to the heap structure
+ * @param dest Destination
+ * @return 0 on success, -1 on error
+ */
+int minmax_heap_peek_front(minmax_heap_t *heap, void *dest)
+{
+    node_t *front = minmax_heap_front(heap);
+
+    if ((front != NULL) && (dest != NULL))
+    {
+        // Copy peeked data into its destination
+        memcpy(dest, front->data, front->data_size);
+        return 0;
+    }
+    return -1;
+}
+
+/**
+ * @brief Peek the item with the lowest priority in a heap
+ * @param heap Pointer to the heap structure
+ * @param dest Destination
+ * @return 0 on success, -1 on error
+ */
+int minmax_heap_peek_back(minmax_heap_t *heap, void *dest)
+{
+    node_t *back = minmax_heap_back(heap);
+
+    if ((back != NULL) && (dest != NULL))
+    {
+        // Copy peeked data into its destination
+        memcpy(dest, back->data, back->data_size);
+        return 0;
+    }
+    return -1;
+}
+
+/**
+ * @brief Get a pointer to the item with the highest priority in a heap
+ * @param heap Pointer to the heap structure
+ * @return A pointer to the root node, NULL if the heap is empty
+ */
+node_t *minmax_heap_front(minmax_heap_t *heap)
+{
+    return ((heap != NULL) && (heap->size != 0)) ? heap->nodes[0] : NULL;
+}
+
+/**
+ * @brief Get a pointer to the item with the lowest priority in a heap
+ * @param heap Pointer to the heap structure
+ * @return A pointer to the node, NULL if the heap is empty
+ */
+node_t *minmax_heap_back(minmax_heap_t *heap)
+{
+    return ((heap != NULL) && (heap->size != 0)) ? heap->nodes[back_index(heap)] : NULL;
+}
+
+/**
+ * @brief Clear a heap's contents
+ * @param heap Pointer to the heap structure
+ */
+void minmax_heap_clear(minmax_heap_t *heap)
+{
+#ifdef DEBUG
+    printf("Clearing min-max heap...\n");
+#endif
+    while (heap->size > 0)
+    {
+        free(heap->nodes[--heap->size]);
+    }
+}
+
+/**
+ * @brief Restore the min-max heap property after the comparison function changes
+ * @param heap Pointer to the heap structure
+ * @param compare New comparison function
+ * @note Uses bottom-up heap construction, O(n)
+ */
+void minmax_heap_rebuild(minmax_heap_t *heap, cmp_func_t compare)
+{
+    size_t i;
+
+    heap->compare = compare;
+    if (heap->size < 2)
+        return;
+
+    // Trickle every parent down, starting from the last one
+    i = heap->size / 2;
+    while (i-- > 0)
+    {
+        trickle_down(heap, i);
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef _MINMAX_HEAP_H
+#define _MINMAX_HEAP_H
+
+#include "sorted_list.h"
+
+typedef struct minmax_heap
+{
+    node_t **nodes;
+    size_t size;
+    size_t capacity;
+    cmp_func_t compare;
+} minmax_heap_t;
+
+minmax_heap_t *minmax_heap_new(cmp_func_t compare);
+void minmax_heap_destroy(minmax_heap_t *heap);
+int minmax_heap_empty(minmax_heap_t *heap);
+size_t minmax_heap_size(minmax_heap_t *heap);
+int minmax_heap_push(minmax_heap_t *heap, void *data, size_t data_size);
+void minmax_heap_pop_front(minmax_heap_t *heap, void *dest);
+void minmax_heap_pop_back(minmax_heap_t *heap, void *dest);
+int minmax_heap_peek_front(minmax_heap_t *heap, void *dest);
+int minmax_heap_peek_back(minmax_heap_t *heap, void *dest);
+node_t *minmax_heap_front(minmax_heap_t *heap);
+node_t *minmax_heap_back(minmax_heap_t *heap);
+void minmax_heap_clear(minmax_heap_t *heap);
+void minmax_heap_rebuild(minmax_heap_t *heap, cmp_func_t compare);
+
+#endif
@@ -0,0 +1,284 @@
+#include "mpmc_queue.h"
+#include <string.h>
+#include <sched.h>
+
+#ifdef DEBUG
+#include <stdio.h>
+#endif
+
+#define MPMC_QUEUE_MIN_CAPACITY 2
+// Failed attempts a blocking call spins through before yielding the processor
+#define MPMC_QUEUE_SPIN_LIMIT 64
+
+/**
+ * @brief Get the sequence number of the cell for a given position
+ * @param queue Pointer to the queue structure
+ * @param position Position in the queue
+ * @return A pointer to the cell's sequence number, the item follows it
+ * @note Internal use only
+ */
+static atomic_size_t *cell_at(mpmc_queue_t *queue, size_t position)
+{
+    return (atomic_size_t *)(queue->cells + (position & queue->mask) * queue->cell_size);
+}
+
+/**
+ * @brief Multi-producer/multi-consumer queue constructor
+ * @param elem_size Size of every item the queue stores in bytes
+ * @param capacity Minimum number of items the queue must hold, rounded up to a power of two
+ * @return An owning pointer that points to the new queue structure on success, NULL on error
+ * @note The queue never grows. Every cell carries a sequence number telling which lap of the
+ *       ring it is ready for, so threads only contend on the position they claim.
+ */
+mpmc_queue_t *mpmc_queue_new(size_t elem_size, size_t capacity)
+{
+    mpmc_queue_t *new_queue;
+    size_t slots = MPMC_QUEUE_MIN_CAPACITY;
+    size_t i;
+
+    // Empty items aren't supported
+    if (elem_size == 0)
+        return NULL;
+    while (slots < capacity)
+        slots <<= 1;
+
+    // Reserve memory for the new queue structure, aligned so padded indices own their cache lines
+    new_queue = aligned_alloc(MPMC_QUEUE_CACHE_LINE, sizeof *new_queue);
+    if (new_queue != NULL)
+    {
+        // Cells are padded so every sequence number stays aligned
+        new_queue->cell_size = sizeof(atomic_size_t) + elem_size;
+        new_queue->cell_size = (new_queue->cell_size + _Alignof(atomic_size_t) - 1) & ~(_Alignof(atomic_size_t) - 1);
+        new_queue->cells = malloc(slots * new_queue->cell_size);
+        if (new_queue->cells == NULL)
+        {
+            free(new_queue);
+            return NULL;
+        }
+        new_queue->elem_size = elem_size;
+        new_queue->mask = slots - 1;
+        atomic_init(&new_queue->head, 0);
+        atomic_init(&new_queue->tail, 0);
+
+        // Every cell starts ready for a producer on the first lap
+        for (i = 0; i < slots; i++)
+            atomic_init(cell_at(new_queue, i), i);
+    }
+
+    // Return a pointer to the new queue structure
+#ifdef DEBUG
+    printf("Created MPMC queue at %lx\n", (long unsigned int)new_queue);
+#endif
+    return new_queue;
+}
+
+/**
+ * @brief Multi-producer/multi-consumer queue destructor
+ * @param queue Pointer to the queue structure to be destroyed
+ * @note No thread may be using the queue anymore
+ */
+void mpmc_queue_destroy(mpmc_queue_t *queue)
+{
+    if (queue != NULL)
+    {
+        free(queue->cells);
+        free(queue);
+#ifdef DEBUG
+        printf("Destroyed MPMC queue at %lx\n", (long unsigned int)queue);
+#endif
+    }
+}
+
+/**
+ * @brief Check if a queue contains no items
+ * @param queue Pointer to the queue structure
+ * @return 1 for empty, 0 otherwise
+ * @note Only a snapshot when other threads are running concurrently
+ */
+int mpmc_queue_empty(mpmc_queue_t *queue)
+{
+    return (mpmc_queue_size(queue) == 0) ? 1 : 0;
+}
+
+/**
+ * @brief Check the number of items a queue contains
+ * @param queue Pointer to the queue structure
+ * @return Number of claimed positions between consumers and producers
+ * @note Only a snapshot when other threads are running concurrently
+ */
+size_t mpmc_queue_size(mpmc_queue_t *queue)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+    // Consumers may briefly run ahead of the tail snapshot
+    return (tail > head) ? tail - head : 0;
+}
+
+/**
+ * @brief Check the number of items a queue can hold
+ * @param queue Pointer to the queue structure
+ * @return Capacity of the queue
+ */
+size_t mpmc_queue_capacity(mpmc_queue_t *queue)
+{
+    return queue->mask + 1;
+}
+
+/**
+ * @brief Append an item to a queue if there is room for it
+ * @param queue Pointer to the queue structure
+ * @param data Data to be copied into the queue, elem_size bytes long
+ * @return 0 on success, -1 if the queue is full
+ */
+int mpmc_queue_try_push(mpmc_queue_t *queue, void *data)
+{
+    return (mpmc_queue_try_push_n(queue, data, 1) == 1) ? 0 : -1;
+}
+
+/**
+ * @brief Extract the oldest item from a queue if there is any
+ * @param queue Pointer to the queue structure
+ * @param dest Destination, elem_size bytes long, or NULL to discard the item
+ * @return 0 on success, -1 if the queue is empty
+ */
+int mpmc_queue_try_pop(mpmc_queue_t *queue, void *dest)
+{
+    return (mpmc_queue_try_pop_n(queue, dest, 1) == 1) ? 0 : -1;
+}
+
+/**
+ * @brief Append an item to a queue, waiting for room if it is full
+ * @param queue Pointer to the queue structure
+ * @param data Data to be copied into the queue, elem_size bytes long
+ * @note Spins for a while, then yields the processor between attempts
+ */
+void mpmc_queue_push(mpmc_queue_t *queue, void *data)
+{
+    int spins = 0;
+
+    while (mpmc_queue_try_push_n(queue, data, 1) == 0)
+    {
+        if (++spins >= MPMC_QUEUE_SPIN_LIMIT)
+        {
+            sched_yield();
+            spins = 0;
+        }
+    }
+}
+
+/**
+ * @brief Extract the oldest item from a queue, waiting for one if it is empty
+ * @param queue Pointer to the queue structure
+ * @param dest Destination, elem_size bytes long, or NULL to discard the item
+ * @note Spins for a while, then yields the processor between attempts
+ */
+void mpmc_queue_pop(mpmc_queue_t *queue, void *dest)
+{
+    int spins = 0;
+
+    while (mpmc_queue_try_pop_n(queue, dest, 1) == 0)
+    {
+        if (++spins >= MPMC_QUEUE_SPIN_LIMIT)
+        {
+            sched_yield();
+            spins = 0;
+        }
+    }
+}
+
+/**
+ * @brief Append up to count items to a queue at once
+ * @param queue Pointer to the queue structure
+ * @param data Array of count items to be copied into the queue
+ * @param count Maximum number of items to append
+ * @return Number of items appended, taken from the start of data
+ * @note The whole batch is claimed with a single compare-and-swap
+ */
+size_t mpmc_queue_try_push_n(mpmc_queue_t *queue, void *data, size_t count)
+{
+    size_t position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    size_t ready, current, i;
+    atomic_size_t *cell;
+
+    while (1)
+    {
+        // Count how many cells from the claimed position were released by consumers on the previous lap
+        for (ready = 0; ready < count; ready++)
+        {
+            if (atomic_load_explicit(cell_at(queue, position + ready), memory_order_acquire) != position + ready)
+                break;
+        }
+        if (ready == 0)
+        {
+            // Either the queue is full, or another producer already took this position
+            current = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+            if (current == position)
+                return 0;
+            position = current;
+            continue;
+        }
+        // Those cells can only be reused by whoever claims their positions
+        if (atomic_compare_exchange_weak_explicit(&queue->tail, &position, position + ready,
+                                                  memory_order_relaxed, memory_order_relaxed))
+            break;
+    }
+
+    // Fill the claimed cells and hand each one over to consumers
+    for (i = 0; i < ready; i++)
+    {
+        cell = cell_at(queue, position + i);
+        memcpy(cell + 1, (unsigned char *)data + i * queue->elem_size, queue->elem_size);
+        atomic_store_explicit(cell, position + i + 1, memory_order_release);
+    }
+
+    return ready;
+}
+
+/**
+ * @brief Extract up to count of the oldest items from a queue at once
+ * @param queue Pointer to the queue structure
+ * @param dest Destination array with room for count items, or NULL to discard them
+ * @param count Maximum number of items to extract
+ * @return Number of items extracted
+ * @note The whole batch is claimed with a single compare-and-swap
+ */
+size_t mpmc_queue_try_pop_n(mpmc_queue_t *queue, void *dest, size_t count)
+{
+    size_t position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    size_t ready, current, i;
+    atomic_size_t *cell;
+
+    while (1)
+    {
+        // Count how many cells from the claimed position were filled by producers on this lap
+        for (ready = 0; ready < count; ready++)
+        {
+            if (atomic_load_explicit(cell_at(queue, position + ready), memory_order_acquire) != position + ready + 1)
+                break;
+        }
+        if (ready == 0)
+        {
+            // Either the queue is empty, or another consumer already took this position
+            current = atomic_load_explicit(&queue->head, memory_order_relaxed);
+            if (current == position)
+                return 0;
+            position = current;
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(&queue->head, &position, position + ready,
+                                                  memory_order_relaxed, memory_order_relaxed))
+            break;
+    }
+
+    // Copy the claimed items out and release each cell to producers on the next lap
+    for (i = 0; i < ready; i++)
+    {
+        cell = cell_at(queue, position + i);
+        if (dest != NULL)
+            memcpy((unsigned char *)dest + i * queue->elem_size, cell + 1, queue->elem_size);
+        atomic_store_explicit(cell, position + i + queue->mask + 1, memory_order_release);
+    }
+
+    return ready;
+}
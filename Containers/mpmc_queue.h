@@ -0,0 +1,35 @@
+#ifndef _MPMC_QUEUE_H
+#define _MPMC_QUEUE_H
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+// Indices written by different threads live on different cache lines to avoid false sharing
+#define MPMC_QUEUE_CACHE_LINE 64
+
+typedef struct mpmc_queue
+{
+    // Next position to be claimed by a producer
+    _Alignas(MPMC_QUEUE_CACHE_LINE) atomic_size_t tail;
+    // Next position to be claimed by a consumer
+    _Alignas(MPMC_QUEUE_CACHE_LINE) atomic_size_t head;
+    // Read-only after construction, every cell is a sequence number followed by an item
+    _Alignas(MPMC_QUEUE_CACHE_LINE) unsigned char *cells;
+    size_t cell_size;
+    size_t elem_size;
+    size_t mask;
+} mpmc_queue_t;
+
+mpmc_queue_t *mpmc_queue_new(size_t elem_size, size_t capacity);
+void mpmc_queue_destroy(mpmc_queue_t *queue);
+int mpmc_queue_empty(mpmc_queue_t *queue);
+size_t mpmc_queue_size(mpmc_queue_t *queue);
+size_t mpmc_queue_capacity(mpmc_queue_t *queue);
+int mpmc_queue_try_push(mpmc_queue_t *queue, void *data);
+int mpmc_queue_try_pop(mpmc_queue_t *queue, void *dest);
+void mpmc_queue_push(mpmc_queue_t *queue, void *data);
+void mpmc_queue_pop(mpmc_queue_t *queue, void *dest);
+size_t mpmc_queue_try_push_n(mpmc_queue_t *queue, void *data, size_t count);
+size_t mpmc_queue_try_pop_n(mpmc_queue_t *queue, void *dest, size_t count);
+
+#endif
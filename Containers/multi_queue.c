@@ -0,0 +1,285 @@
+#include "multi_queue.h"
+#include <stdint.h>
+#include <sched.h>
+#include <unistd.h>
+
+#ifdef DEBUG
+#include <stdio.h>
+#endif
+
+// Failed attempts a call spins through before yielding the processor
+#define MULTI_QUEUE_SPIN_LIMIT 64
+
+/**
+ * @brief Pick a random internal heap
+ * @param queue Pointer to the queue structure
+ * @return Index of the heap
+ * @note Every thread runs its own xorshift generator, seeded from its address. Internal use only
+ */
+static size_t random_slot(multi_queue_t *queue)
+{
+    static _Thread_local uint32_t state;
+
+    if (state == 0)
+        state = (uint32_t)((uintptr_t)&state >> 4) | 1;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state % queue->count;
+}
+
+/**
+ * @brief Try to take the lock of an internal heap
+ * @param slot Pointer to the heap's slot
+ * @return Non-zero if the lock was taken
+ * @note Internal use only
+ */
+static int slot_try_lock(multi_queue_slot_t *slot)
+{
+    return !atomic_flag_test_and_set_explicit(&slot->lock, memory_order_acquire);
+}
+
+/**
+ * @brief Release the lock of an internal heap
+ * @param slot Pointer to the heap's slot
+ * @note Internal use only
+ */
+static void slot_unlock(multi_queue_slot_t *slot)
+{
+    atomic_flag_clear_explicit(&slot->lock, memory_order_release);
+}
+
+/**
+ * @brief Publish the number of items of an internal heap
+ * @param slot Pointer to the heap's slot, locked by the caller
+ * @note Every heap keeps its own counter, so pushes and pops to different heaps never share a
+ *       cache line. Internal use only
+ */
+static void slot_publish_size(multi_queue_slot_t *slot)
+{
+    atomic_store_explicit(&slot->size, heap_size(slot->heap), memory_order_release);
+}
+
+/**
+ * @brief Count a failed attempt, yielding the processor once in a while
+ * @param attempts Pointer to the number of failed attempts
+ * @note Internal use only
+ */
+static void backoff(unsigned int *attempts)
+{
+    if (++*attempts % MULTI_QUEUE_SPIN_LIMIT == 0)
+        sched_yield();
+}
+
+/**
+ * @brief Relaxed concurrent priority queue constructor
+ * @param compare Comparison function used to decide which of two items has priority
+ * @param threads Number of threads expected to use the queue, 0 for the number of online processors
+ * @param factor Number of internal heaps per thread, at least 2 keeps lock contention low
+ * @return An owning pointer that points to the new queue structure on success, NULL on error
+ * @note Items are spread over threads * factor heaps, each behind its own lock. Pushes go to a random
+ *       heap, pops take the better front of two random heaps. Pops are not exact: the popped item's
+ *       rank is O(threads * factor) on average, in exchange for throughput that scales with threads.
+ */
+multi_queue_t *multi_queue_new(cmp_func_t compare, size_t threads, size_t factor)
+{
+    multi_queue_t *new_queue;
+    long online;
+    size_t i;
+
+    if (threads == 0)
+    {
+        online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (size_t)online : 1;
+    }
+    if (factor == 0)
+        factor = 1;
+
+    // Reserve memory for the new queue structure
+    new_queue = malloc(sizeof *new_queue);
+    if (new_queue != NULL)
+    {
+        // At least two heaps are needed for pops to have a choice
+        new_queue->count = (threads * factor > 1) ? threads * factor : 2;
+        new_queue->slots = aligned_alloc(MULTI_QUEUE_CACHE_LINE, new_queue->count * sizeof *new_queue->slots);
+        if (new_queue->slots == NULL)
+        {
+            free(new_queue);
+            return NULL;
+        }
+        for (i = 0; i < new_queue->count; i++)
+        {
+            atomic_flag_clear(&new_queue->slots[i].lock);
+            atomic_init(&new_queue->slots[i].size, 0);
+            new_queue->slots[i].heap = heap_new(compare);
+            if (new_queue->slots[i].heap == NULL)
+            {
+                new_queue->count = i;
+                multi_queue_destroy(new_queue);
+                return NULL;
+            }
+        }
+        new_queue->compare = compare;
+    }
+
+    // Return a pointer to the new queue structure
+#ifdef DEBUG
+    printf("Created multi queue at %lx\n", (long unsigned int)new_queue);
+#endif
+    return new_queue;
+}
+
+/**
+ * @brief Relaxed concurrent priority queue destructor
+ * @param queue Pointer to the queue structure to be destroyed
+ * @note No thread may be using the queue anymore
+ */
+void multi_queue_destroy(multi_queue_t *queue)
+{
+    size_t i;
+
+    if (queue != NULL)
+    {
+        // Destroy every heap before freeing the memory allocated to the queue structure
+        for (i = 0; i < queue->count; i++)
+        {
+            heap_destroy(queue->slots[i].heap);
+        }
+        free(queue->slots);
+        free(queue);
+#ifdef DEBUG
+        printf("Destroyed multi queue at %lx\n", (long unsigned int)queue);
+#endif
+    }
+}
+
+/**
+ * @brief Check if a queue contains no items
+ * @param queue Pointer to the queue structure
+ * @return 1 for empty, 0 otherwise
+ * @note Only a snapshot when other threads are running concurrently
+ */
+int multi_queue_empty(multi_queue_t *queue)
+{
+    return (multi_queue_size(queue) == 0) ? 1 : 0;
+}
+
+/**
+ * @brief Check the number of items a queue contains
+ * @param queue Pointer to the queue structure
+ * @return Number of items contained in the queue
+ * @note Only a snapshot when other threads are running concurrently. O(number of heaps)
+ */
+size_t multi_queue_size(multi_queue_t *queue)
+{
+    size_t size = 0;
+    size_t i;
+
+    // Sum up the counters of every heap
+    for (i = 0; i < queue->count; i++)
+        size += atomic_load_explicit(&queue->slots[i].size, memory_order_acquire);
+    return size;
+}
+
+/**
+ * @brief Check the number of internal heaps of a queue
+ * @param queue Pointer to the queue structure
+ * @return Number of heaps
+ */
+size_t multi_queue_heaps(multi_queue_t *queue)
+{
+    return queue->count;
+}
+
+/**
+ * @brief Push a new data item into a queue
+ * @param queue Pointer to the queue structure
+ * @param data New data item
+ * @param data_size Size of data in bytes
+ * @return 0 on success, -1 on error
+ * @note Safe to call from any number of threads
+ */
+int multi_queue_push(multi_queue_t *queue, void *data, size_t data_size)
+{
+    multi_queue_slot_t *slot;
+    unsigned int attempts = 0;
+    int result;
+
+    // Any heap will do, so a locked one is simply skipped
+    for (;;)
+    {
+        slot = &queue->slots[random_slot(queue)];
+        if (slot_try_lock(slot))
+            break;
+        backoff(&attempts);
+    }
+    result = heap_push(slot->heap, data, data_size);
+    if (result == 0)
+        slot_publish_size(slot);
+    slot_unlock(slot);
+
+    return result;
+}
+
+/**
+ * @brief Pop an item with a high priority from a queue
+ * @param queue Pointer to the queue structure
+ * @param dest Destination
+ * @return 0 on success, -1 if the queue is empty
+ * @note Safe to call from any number of threads. The item comes from the better of two random heaps,
+ *       so it is close to, but not always, the item with the highest priority in the queue.
+ *       Emptiness is only checked over every heap once both picked heaps turn out empty
+ */
+int multi_queue_pop(multi_queue_t *queue, void *dest)
+{
+    multi_queue_slot_t *first, *second, *best;
+    node_t *first_front, *second_front;
+    unsigned int attempts = 0;
+
+    for (;;)
+    {
+        // Lock two distinct heaps, giving up on both if either is busy
+        first = &queue->slots[random_slot(queue)];
+        do
+        {
+            second = &queue->slots[random_slot(queue)];
+        } while (second == first);
+        if (!slot_try_lock(first))
+        {
+            backoff(&attempts);
+            continue;
+        }
+        if (!slot_try_lock(second))
+        {
+            slot_unlock(first);
+            backoff(&attempts);
+            continue;
+        }
+
+        // Pop from the heap whose front has priority
+        first_front = heap_front(first->heap);
+        second_front = heap_front(second->heap);
+        if (first_front == NULL)
+            best = second;
+        else if (second_front == NULL)
+            best = first;
+        else
+            best = (queue->compare(second_front->data, second_front->data_size, first_front->data, first_front->data_size) < 0) ? second : first;
+        if (heap_empty(best->heap))
+        {
+            // Both heaps are empty, the items are elsewhere if there are any left
+            slot_unlock(second);
+            slot_unlock(first);
+            if (multi_queue_empty(queue))
+                return -1;
+            backoff(&attempts);
+            continue;
+        }
+        heap_pop(best->heap, dest);
+        slot_publish_size(best);
+        slot_unlock(second);
+        slot_unlock(first);
+
+        return 0;
+    }
+}
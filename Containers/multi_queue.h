@@ -0,0 +1,34 @@
+#ifndef _MULTI_QUEUE_H
+#define _MULTI_QUEUE_H
+
+#include "heap.h"
+#include <stdatomic.h>
+
+// Every internal heap owns its cache line, so locking one doesn't slow down threads using another
+#define MULTI_QUEUE_CACHE_LINE 64
+
+typedef struct multi_queue_slot
+{
+    _Alignas(MULTI_QUEUE_CACHE_LINE) atomic_flag lock;
+    heap_t *heap;
+    // Number of items in the heap, written under the lock and readable without it
+    atomic_size_t size;
+} multi_queue_slot_t;
+
+typedef struct multi_queue
+{
+    // Read-only after construction
+    multi_queue_slot_t *slots;
+    size_t count;
+    cmp_func_t compare;
+} multi_queue_t;
+
+multi_queue_t *multi_queue_new(cmp_func_t compare, size_t threads, size_t factor);
+void multi_queue_destroy(multi_queue_t *queue);
+int multi_queue_empty(multi_queue_t *queue);
+size_t multi_queue_size(multi_queue_t *queue);
+size_t multi_queue_heaps(multi_queue_t *queue);
+int multi_queue_push(multi_queue_t *queue, void *data, size_t data_size);
+int multi_queue_pop(multi_queue_t *queue, void *dest);
+
+#endif
@@ -0,0 +1,201 @@
+#include "node_pool.h"
+#ifdef DEBUG
+#include <stdio.h>
+#endif
+
+// Blocks and slab headers are padded to this boundary so any payload type can live in a block
+#define NODE_POOL_ALIGNMENT 16
+#define NODE_POOL_ROUND_UP(x) (((x) + NODE_POOL_ALIGNMENT - 1) & ~((size_t)NODE_POOL_ALIGNMENT - 1))
+#define NODE_POOL_DEFAULT_BLOCKS_PER_SLAB 64
+
+/**
+ * @brief Node pool constructor
+ * @param block_size Size of each block handed out by the pool in bytes
+ * @param blocks_per_slab Number of blocks reserved at once when the pool runs dry, 0 for a default
+ * @return An owning pointer that points to the new pool on success, NULL on error
+ */
+node_pool_t *node_pool_new(size_t block_size, size_t blocks_per_slab)
+{
+    node_pool_t *new_pool;
+
+    if (block_size == 0)
+        return NULL;
+
+    // Reserve memory for the new pool structure
+    new_pool = malloc(sizeof *new_pool);
+    if (new_pool != NULL)
+    {
+        // Initialize the structure, no slab is reserved until the first allocation
+        new_pool->block_size = NODE_POOL_ROUND_UP(block_size < sizeof(node_pool_block_t) ? sizeof(node_pool_block_t) : block_size);
+        new_pool->blocks_per_slab = (blocks_per_slab != 0) ? blocks_per_slab : NODE_POOL_DEFAULT_BLOCKS_PER_SLAB;
+        new_pool->blocks_in_use = 0;
+        new_pool->users = 1;
+        new_pool->slabs = NULL;
+        new_pool->free_list = NULL;
+        new_pool->stats = (node_pool_stats_t){ 0 };
+    }
+
+    // Return a pointer to the new pool structure
+#ifdef DEBUG
+    printf("Created node pool at %lx\n", (unsigned long int)new_pool);
+#endif
+    return new_pool;
+}
+
+/**
+ * @brief Free every slab owned by a pool
+ * @param pool Pointer to the pool structure
+ * @note Internal use only
+ */
+static void node_pool_free_slabs(node_pool_t *pool)
+{
+    node_pool_slab_t *slab;
+
+    while (pool->slabs != NULL)
+    {
+        slab = pool->slabs;
+        pool->slabs = slab->next;
+        free(slab);
+        pool->stats.slab_frees++;
+    }
+    pool->free_list = NULL;
+}
+
+/**
+ * @brief Register one more user of a pool
+ * @param pool Pointer to the pool structure
+ * @return The same pool, which every user must destroy once
+ */
+node_pool_t *node_pool_share(node_pool_t *pool)
+{
+    if (pool != NULL)
+        pool->users++;
+    return pool;
+}
+
+/**
+ * @brief Node pool destructor
+ * @param pool Pointer to the pool structure to be destroyed
+ * @note The pool is only freed along with its last user. Every block handed out by it becomes invalid then
+ */
+void node_pool_destroy(node_pool_t *pool)
+{
+    if ((pool != NULL) && (--pool->users == 0))
+    {
+        node_pool_free_slabs(pool);
+        free(pool);
+#ifdef DEBUG
+        printf("Destroyed node pool at %lx\n", (unsigned long int)pool);
+#endif
+    }
+}
+
+/**
+ * @brief Reserve a new slab and thread its blocks onto the free list
+ * @param pool Pointer to the pool structure
+ * @return 0 on success, -1 on error
+ * @note Internal use only
+ */
+static int node_pool_grow(node_pool_t *pool)
+{
+    node_pool_slab_t *slab;
+    unsigned char *block;
+    size_t i;
+
+    slab = malloc(NODE_POOL_ROUND_UP(sizeof *slab) + pool->block_size * pool->blocks_per_slab);
+    if (slab == NULL)
+        return -1;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->stats.slab_allocs++;
+
+    // Push every block of the new slab onto the free list
+    block = (unsigned char *)slab + NODE_POOL_ROUND_UP(sizeof *slab);
+    for (i = 0; i < pool->blocks_per_slab; i++)
+    {
+        ((node_pool_block_t *)block)->next = pool->free_list;
+        pool->free_list = (node_pool_block_t *)block;
+        block += pool->block_size;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get a block from a pool
+ * @param pool Pointer to the pool structure, NULL to fall back to malloc
+ * @param size Number of bytes needed
+ * @return A pointer to the block on success, NULL on error
+ * @note Requests larger than the pool's block size are served by malloc
+ */
+void *node_pool_alloc(node_pool_t *pool, size_t size)
+{
+    node_pool_block_t *block;
+
+    if (pool == NULL)
+        return malloc(size);
+
+    if (size > pool->block_size)
+    {
+        pool->stats.fallback_allocs++;
+        return malloc(size);
+    }
+
+    // Recycle a free block, reserving a whole new slab only when none is left
+    if ((pool->free_list == NULL) && (node_pool_grow(pool) != 0))
+        return NULL;
+    block = pool->free_list;
+    pool->free_list = block->next;
+    pool->blocks_in_use++;
+    pool->stats.block_allocs++;
+
+    return block;
+}
+
+/**
+ * @brief Give a block back to a pool
+ * @param pool Pointer to the pool structure, NULL if the block came from malloc
+ * @param block Pointer to the block
+ * @param size Number of bytes requested when the block was allocated
+ */
+void node_pool_free(node_pool_t *pool, void *block, size_t size)
+{
+    if (block == NULL)
+        return;
+
+    if (pool == NULL)
+    {
+        free(block);
+        return;
+    }
+
+    if (size > pool->block_size)
+    {
+        pool->stats.fallback_frees++;
+        free(block);
+        return;
+    }
+
+    // The block is threaded back onto the free list for later reuse
+    ((node_pool_block_t *)block)->next = pool->free_list;
+    pool->free_list = block;
+    pool->blocks_in_use--;
+    pool->stats.block_frees++;
+}
+
+/**
+ * @brief Give every slab of a pool back to the system
+ * @param pool Pointer to the pool structure
+ * @return 0 on success, -1 if some blocks are still in use
+ */
+int node_pool_release(node_pool_t *pool)
+{
+    if ((pool == NULL) || (pool->blocks_in_use != 0))
+        return -1;
+
+    node_pool_free_slabs(pool);
+#ifdef DEBUG
+    printf("Released slabs of node pool at %lx\n", (unsigned long int)pool);
+#endif
+    return 0;
+}
@@ -0,0 +1,47 @@
+#ifndef _NODE_POOL_H
+#define _NODE_POOL_H
+
+#include <stdlib.h>
+
+typedef struct node_pool_slab node_pool_slab_t;
+typedef struct node_pool_block node_pool_block_t;
+
+struct node_pool_slab
+{
+    node_pool_slab_t *next;
+};
+
+struct node_pool_block
+{
+    node_pool_block_t *next;
+};
+
+typedef struct node_pool_stats
+{
+    size_t slab_allocs;
+    size_t slab_frees;
+    size_t block_allocs;
+    size_t block_frees;
+    size_t fallback_allocs;
+    size_t fallback_frees;
+} node_pool_stats_t;
+
+typedef struct node_pool
+{
+    size_t block_size;
+    size_t blocks_per_slab;
+    size_t blocks_in_use;
+    size_t users;
+    node_pool_slab_t *slabs;
+    node_pool_block_t *free_list;
+    node_pool_stats_t stats;
+} node_pool_t;
+
+node_pool_t *node_pool_new(size_t block_size, size_t blocks_per_slab);
+node_pool_t *node_pool_share(node_pool_t *pool);
+void node_pool_destroy(node_pool_t *pool);
+void *node_pool_alloc(node_pool_t *pool, size_t size);
+void node_pool_free(node_pool_t *pool, void *block, size_t size);
+int node_pool_release(node_pool_t *pool);
+
+#endif
@@ -0,0 +1,482 @@
+#include "pairing_heap.h"
+#include <string.h>
+#ifdef DEBUG
+#include <stdio.h>
+#endif
+
+/**
+ * @brief Tree links of a pairing heap node, stored at the start of its payload
+ * @note The node's next pointer links it to its right sibling
+ */
+typedef struct pairing_links
+{
+    node_t *child;
+    node_t *prev;
+} pairing_links_t;
+
+/**
+ * @brief Get the tree links of a node
+ * @param node Pointer to the node
+ * @return Pointer to the node's links
+ * @note Internal use only
+ */
+static pairing_links_t *links(node_t *node)
+{
+    return (pairing_links_t *)node->payload;
+}
+
+/**
+ * @brief Node constructor
+ * @param data Data to be stored within the new node
+ * @param data_size Size of the datatype stored within the new node in bytes
+ * @return An owning pointer that points to the new node
+ * @note Internal use only
+ */
+static node_t *node_new(void *data, size_t data_size)
+{
+    node_t *new_node;
+
+    // Empty heap items aren't supported
+    if ((data == NULL) || (data_size == 0))
+        return NULL;
+
+    // Reserve memory for the new node, its links and its encapsulated data in a single block
+    new_node = malloc(sizeof *new_node + NODE_PAYLOAD_ROUND_UP(sizeof(pairing_links_t)) + data_size);
+    if (new_node != NULL)
+    {
+        // Initialize the structure as a single node tree
+        new_node->data = new_node->payload + NODE_PAYLOAD_ROUND_UP(sizeof(pairing_links_t));
+        memcpy(new_node->data, data, data_size);
+        new_node->data_size = data_size;
+        new_node->next = NULL;
+        links(new_node)->child = NULL;
+        links(new_node)->prev = NULL;
+    }
+
+    return new_node;
+}
+
+/**
+ * @brief Check if a node must be placed above another one
+ * @param heap Pointer to the heap structure
+ * @param a First node
+ * @param b Second node
+ * @return Non-zero if a has priority over b
+ * @note Internal use only
+ */
+static int node_before(pairing_heap_t *heap, node_t *a, node_t *b)
+{
+    return heap->compare(a->data, a->data_size, b->data, b->data_size) < 0;
+}
+
+/**
+ * @brief Link two trees, the root with the lowest priority becomes the first child of the other one
+ * @param heap Pointer to the heap structure
+ * @param a Root of the first tree, may be NULL
+ * @param b Root of the second tree, may be NULL
+ * @return Root of the linked tree
+ * @note Internal use only
+ */
+static node_t *link_trees(pairing_heap_t *heap, node_t *a, node_t *b)
+{
+    node_t *temp;
+
+    if (a == NULL)
+        return b;
+    if (b == NULL)
+        return a;
+
+    // Keep the winner in a, ties favor the first tree
+    if (node_before(heap, b, a))
+    {
+        temp = a;
+        a = b;
+        b = temp;
+    }
+
+    // b becomes the leftmost child of a
+    b->next = links(a)->child;
+    if (b->next != NULL)
+        links(b->next)->prev = b;
+    links(b)->prev = a;
+    links(a)->child = b;
+    a->next = NULL;
+    links(a)->prev = NULL;
+
+    return a;
+}
+
+/**
+ * @brief Combine a list of sibling trees into a single tree
+ * @param heap Pointer to the heap structure
+ * @param first First sibling, may be NULL
+ * @return Root of the combined tree
+ * @note Two-pass pairing: siblings are linked in pairs left to right, then the pairs are
+ *       linked into one tree right to left. Internal use only
+ */
+static node_t *merge_pairs(pairing_heap_t *heap, node_t *first)
+{
+    node_t *pairs = NULL;
+    node_t *result = NULL;
+    node_t *a, *b, *merged;
+
+    // First pass, the merged pairs are stacked so the second pass sees them right to left
+    while (first != NULL)
+    {
+        a = first;
+        b = a->next;
+        first = (b != NULL) ? b->next : NULL;
+        merged = link_trees(heap, a, b);
+        merged->next = pairs;
+        pairs = merged;
+    }
+
+    // Second pass
+    while (pairs != NULL)
+    {
+        merged = pairs;
+        pairs = pairs->next;
+        result = link_trees(heap, result, merged);
+    }
+
+    // A lone tree keeps stale sibling links, the result must be a proper root
+    if (result != NULL)
+    {
+        result->next = NULL;
+        links(result)->prev = NULL;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Detach a node and its subtree from its parent
+ * @param node Pointer to the node, which must not be the root
+ * @note Internal use only
+ */
+static void cut(node_t *node)
+{
+    node_t *prev = links(node)->prev;
+
+    // The previous node is the parent for a leftmost child, the left sibling otherwise
+    if (links(prev)->child == node)
+        links(prev)->child = node->next;
+    else
+        prev->next = node->next;
+    if (node->next != NULL)
+        links(node->next)->prev = prev;
+    node->next = NULL;
+    links(node)->prev = NULL;
+}
+
+/**
+ * @brief Unlink every node of a tree
+ * @param root Root of the tree, may be NULL
+ * @return A list of all the nodes chained through their next pointer
+ * @note Internal use only
+ */
+static node_t *flatten(node_t *root)
+{
+    node_t *list = NULL;
+    node_t *pending = root;
+    node_t *node, *last;
+
+    while (pending != NULL)
+    {
+        node = pending;
+        pending = node->next;
+
+        // Queue the node's children ahead of the pending nodes
+        if (links(node)->child != NULL)
+        {
+            for (last = links(node)->child; last->next != NULL; last = last->next)
+                ;
+            last->next = pending;
+            pending = links(node)->child;
+        }
+
+        links(node)->child = NULL;
+        links(node)->prev = NULL;
+        node->next = list;
+        list = node;
+    }
+
+    return list;
+}
+
+/**
+ * @brief Pairing heap constructor
+ * @param compare Comparison function used to decide which of two items has priority
+ * @return An owning pointer that points to the new heap on success, NULL on error
+ */
+pairing_heap_t *pairing_heap_new(cmp_func_t compare)
+{
+    pairing_heap_t *new_heap;
+
+    // Reserve memory for the new heap structure
+    new_heap = malloc(sizeof *new_heap);
+    if (new_heap != NULL)
+    {
+        new_heap->root = NULL;
+        new_heap->size = 0;
+        new_heap->compare = compare;
+    }
+
+    // Return a pointer to the new heap structure
+#ifdef DEBUG
+    printf("Created pairing heap at %lx\n", (unsigned long int)new_heap);
+#endif
+    return new_heap;
+}
+
+/**
+ * @brief Pairing heap destructor
+ * @param heap Pointer to the heap structure to be destroyed
+ */
+void pairing_heap_destroy(pairing_heap_t *heap)
+{
+    if (heap != NULL)
+    {
+        // Destroy all nodes before freeing the memory allocated to the heap structure
+        pairing_heap_clear(heap);
+        free(heap);
+#ifdef DEBUG
+        printf("Destroyed pairing heap at %lx\n", (unsigned long int)heap);
+#endif
+    }
+}
+
+/**
+ * @brief Check if a heap contains no items
+ * @param heap Pointer to the heap structure
+ * @return 1 for empty, 0 otherwise
+ */
+int pairing_heap_empty(pairing_heap_t *heap)
+{
+    return (heap->size == 0) ? 1 : 0;
+}
+
+/**
+ * @brief Check the number of items a heap contains
+ * @param heap Pointer to the heap structure
+ * @return Number of items contained in the heap
+ */
+size_t pairing_heap_size(pairing_heap_t *heap)
+{
+    return heap->size;
+}
+
+/**
+ * @brief Insert an item into a heap
+ * @param heap Pointer to the heap structure
+ * @param data Data to be stored within the new item
+ * @param data_size Size of data in bytes
+ * @return A handle to the new item on success, NULL on error
+ * @note O(1). The handle stays valid until the item is popped or erased, including across melds
+ */
+node_t *pairing_heap_push(pairing_heap_t *heap, void *data, size_t data_size)
+{
+    node_t *new_item;
+
+    // Create a new node to encapsulate the data
+    new_item = node_new(data, data_size);
+    if (new_item == NULL)
+        return NULL;
+
+    // A new item is a single node tree linked with the root
+    heap->root = link_trees(heap, heap->root, new_item);
+    heap->size++;
+
+    return new_item;
+}
+
+/**
+ * @brief Extract the item with the highest priority from a heap
+ * @param heap Pointer to the heap structure
+ * @param dest Destination
+ */
+void pairing_heap_pop(pairing_heap_t *heap, void *dest)
+{
+    // The heap must exist and have at least one item to pop
+    if ((heap == NULL) || (heap->size == 0))
+        return;
+
+    pairing_heap_erase(heap, heap->root, dest);
+}
+
+/**
+ * @brief Peek the item with the highest priority in a heap
+ * @param heap Pointer to the heap structure
+ * @param dest Destination
+ * @return 0 on success, -1 on error
+ */
+int pairing_heap_peek(pairing_heap_t *heap, void *dest)
+{
+    if ((heap != NULL) && (heap->size != 0) && (dest != NULL))
+    {
+        // Copy peeked data into its destination
+        memcpy(dest, heap->root->data, heap->root->data_size);
+        return 0;
+    }
+    return -1;
+}
+
+/**
+ * @brief Get a pointer to the item with the highest priority in a heap
+ * @param heap Pointer to the heap structure
+ * @return A pointer to the root node, NULL if the heap is empty
+ */
+node_t *pairing_heap_front(pairing_heap_t *heap)
+{
+    return (heap != NULL) ? heap->root : NULL;
+}
+
+/**
+ * @brief Get a pointer to the item with the lowest priority in a heap
+ * @param heap Pointer to the heap structure
+ * @return A pointer to the node, NULL if the heap is empty
+ * @note Only leaves are compared, but every node is visited, O(n)
+ */
+node_t *pairing_heap_back(pairing_heap_t *heap)
+{
+    node_t *back = NULL;
+    node_t *node;
+
+    if (heap == NULL)
+        return NULL;
+
+    // Depth-first walk, climbing back through the previous links
+    node = heap->root;
+    while (node != NULL)
+    {
+        if (links(node)->child != NULL)
+        {
+            node = links(node)->child;
+            continue;
+        }
+        if ((back == NULL) || node_before(heap, back, node))
+            back = node;
+
+        // Climb until a node with a right sibling is found
+        while ((node != NULL) && (node->next == NULL))
+        {
+            while ((links(node)->prev != NULL) && (links(links(node)->prev)->child != node))
+                node = links(node)->prev;
+            node = links(node)->prev;
+        }
+        if (node != NULL)
+            node = node->next;
+    }
+
+    return back;
+}
+
+/**
+ * @brief Restore the heap property after an item's priority changed
+ * @param heap Pointer to the heap structure
+ * @param handle Handle of the item, as returned by pairing_heap_push()
+ * @note The item's data may be modified in place through the handle before calling this function.
+ *       Amortized O(log n)
+ */
+void pairing_heap_update(pairing_heap_t *heap, node_t *handle)
+{
+    node_t *children;
+
+    // Detach the item and its children, then link them back as separate trees
+    if (handle != heap->root)
+        cut(handle);
+    children = merge_pairs(heap, links(handle)->child);
+    links(handle)->child = NULL;
+    if (handle == heap->root)
+        heap->root = link_trees(heap, handle, children);
+    else
+        heap->root = link_trees(heap, heap->root, link_trees(heap, handle, children));
+}
+
+/**
+ * @brief Remove an item from a heap
+ * @param heap Pointer to the heap structure
+ * @param handle Handle of the item, as returned by pairing_heap_push()
+ * @param dest Destination
+ * @note Amortized O(log n). The handle is invalid afterwards
+ */
+void pairing_heap_erase(pairing_heap_t *heap, node_t *handle, void *dest)
+{
+    node_t *children;
+
+    // The item's children are combined and take its place
+    children = merge_pairs(heap, links(handle)->child);
+    if (handle == heap->root)
+    {
+        heap->root = children;
+    }
+    else
+    {
+        cut(handle);
+        heap->root = link_trees(heap, heap->root, children);
+    }
+    heap->size--;
+
+    // Data from the erased node is copied into destination if provided
+    if (dest != NULL)
+    {
+        memcpy(dest, handle->data, handle->data_size);
+    }
+    // Finally, the erased node is destroyed
+    free(handle);
+}
+
+/**
+ * @brief Move all items of a heap into another one
+ * @param dest Pointer to the heap structure receiving the items
+ * @param src Pointer to the heap structure giving its items, left empty
+ * @note O(1) when both heaps use the same comparison function, otherwise src's items are paired
+ *       again under dest's comparison function in O(n) and src keeps its own.
+ *       Handles to src's items stay valid and now refer to items of dest
+ */
+void pairing_heap_meld(pairing_heap_t *dest, pairing_heap_t *src)
+{
+    if ((dest == src) || (src->root == NULL))
+        return;
+
+    // Source nodes are paired again under the destination's comparison function, src keeps its own
+    if (src->compare != dest->compare)
+        src->root = merge_pairs(dest, flatten(src->root));
+    dest->root = link_trees(dest, dest->root, src->root);
+    dest->size += src->size;
+    src->root = NULL;
+    src->size = 0;
+}
+
+/**
+ * @brief Clear a heap's contents
+ * @param heap Pointer to the heap structure
+ */
+void pairing_heap_clear(pairing_heap_t *heap)
+{
+    node_t *node;
+    node_t *next;
+
+#ifdef DEBUG
+    printf("Clearing pairing heap...\n");
+#endif
+    for (node = flatten(heap->root); node != NULL; node = next)
+    {
+        next = node->next;
+        free(node);
+    }
+    heap->root = NULL;
+    heap->size = 0;
+}
+
+/**
+ * @brief Restore the heap property after the comparison function changes
+ * @param heap Pointer to the heap structure
+ * @param compare New comparison function
+ * @note Every node becomes a single node tree, then they are paired, O(n)
+ */
+void pairing_heap_rebuild(pairing_heap_t *heap, cmp_func_t compare)
+{
+    heap->compare = compare;
+    heap->root = merge_pairs(heap, flatten(heap->root));
+}
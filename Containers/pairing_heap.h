@@ -0,0 +1,28 @@
+#ifndef _PAIRING_HEAP_H
+#define _PAIRING_HEAP_H
+
+#include "sorted_list.h"
+
+typedef struct pairing_heap
+{
+    node_t *root;
+    size_t size;
+    cmp_func_t compare;
+} pairing_heap_t;
+
+pairing_heap_t *pairing_heap_new(cmp_func_t compare);
+void pairing_heap_destroy(pairing_heap_t *heap);
+int pairing_heap_empty(pairing_heap_t *heap);
+size_t pairing_heap_size(pairing_heap_t *heap);
+node_t *pairing_heap_push(pairing_heap_t *heap, void *data, size_t data_size);
+void pairing_heap_pop(pairing_heap_t *heap, void *dest);
+int pairing_heap_peek(pairing_heap_t *heap, void *dest);
+node_t *pairing_heap_front(pairing_heap_t *heap);
+node_t *pairing_heap_back(pairing_heap_t *heap);
+void pairing_heap_update(pairing_heap_t *heap, node_t *handle);
+void pairing_heap_erase(pairing_heap_t *heap, node_t *handle, void *dest);
+void pairing_heap_meld(pairing_heap_t *dest, pairing_heap_t *src);
+void pairing_heap_clear(pairing_heap_t *heap);
+void pairing_heap_rebuild(pairing_heap_t *heap, cmp_func_t compare);
+
+#endif
@@ -21,14 +21,22 @@ priority_queue_t *priority_queue_new(cmp_func_t compare, sort_func_t sort)
     if (new_queue != NULL)
     {
         // Also reserved memory for its internal representation
+        new_queue->backend = PRIORITY_QUEUE_SORTED_LIST;
         new_queue->mem = sorted_list_new(compare, sort);
+        new_queue->heap = NULL;
+        new_queue->minmax = NULL;
+        new_queue->pairing = NULL;
+        new_queue->radix = NULL;
         if (new_queue->mem == NULL)
         {
             free(new_queue);
             new_queue = NULL;
         }
-        new_queue->compare = compare;
-        new_queue->sort = sort;
+        else
+        {
+            new_queue->compare = compare;
+            new_queue->sort = sort;
+        }
     }
 
     // Return a pointer to the new queue structure
@@ -38,6 +46,173 @@ priority_queue_t *priority_queue_new(cmp_func_t compare, sort_func_t sort)
     return new_queue;
 }
 
+/**
+ * @brief Heap-backed priority queue constructor
+ * @param compare Comparison function used to decide which of two items has priority
+ * @return An owning pointer that points to the new queue structure on success, NULL on error
+ * @note Items are kept in a contiguous d-ary heap: O(log n) push/pop and O(1) peek.
+ *       Items of equal priority are not guaranteed to pop in insertion order.
+ */
+priority_queue_t *priority_queue_new_heap(cmp_func_t compare)
+{
+    priority_queue_t *new_queue;
+
+    // Reserve memory for the new queue structure
+    new_queue = malloc(sizeof *new_queue);
+    if (new_queue != NULL)
+    {
+        // Also reserved memory for its internal representation
+        new_queue->backend = PRIORITY_QUEUE_HEAP;
+        new_queue->mem = NULL;
+        new_queue->heap = heap_new(compare);
+        new_queue->minmax = NULL;
+        new_queue->pairing = NULL;
+        new_queue->radix = NULL;
+        if (new_queue->heap == NULL)
+        {
+            free(new_queue);
+            new_queue = NULL;
+        }
+        else
+        {
+            new_queue->compare = compare;
+            new_queue->sort = NULL;
+        }
+    }
+
+    // Return a pointer to the new queue structure
+#ifdef DEBUG
+    printf("Created heap queue at %lx\n", (long unsigned int)new_queue);
+#endif
+    return new_queue;
+}
+
+/**
+ * @brief Double-ended priority queue constructor
+ * @param compare Comparison function used to decide which of two items has priority
+ * @return An owning pointer that points to the new queue structure on success, NULL on error
+ * @note Items are kept in a contiguous min-max heap: O(1) front/back peeks and O(log n) push
+ *       and pop from either end. Items of equal priority are not guaranteed to pop in insertion order.
+ */
+priority_queue_t *priority_queue_new_minmax(cmp_func_t compare)
+{
+    priority_queue_t *new_queue;
+
+    // Reserve memory for the new queue structure
+    new_queue = malloc(sizeof *new_queue);
+    if (new_queue != NULL)
+    {
+        // Also reserved memory for its internal representation
+        new_queue->backend = PRIORITY_QUEUE_MINMAX_HEAP;
+        new_queue->mem = NULL;
+        new_queue->heap = NULL;
+        new_queue->minmax = minmax_heap_new(compare);
+        new_queue->pairing = NULL;
+        new_queue->radix = NULL;
+        if (new_queue->minmax == NULL)
+        {
+            free(new_queue);
+            new_queue = NULL;
+        }
+        else
+        {
+            new_queue->compare = compare;
+            new_queue->sort = NULL;
+        }
+    }
+
+    // Return a pointer to the new queue structure
+#ifdef DEBUG
+    printf("Created min-max heap queue at %lx\n", (long unsigned int)new_queue);
+#endif
+    return new_queue;
+}
+
+/**
+ * @brief Addressable priority queue constructor
+ * @param compare Comparison function used to decide which of two items has priority
+ * @return An owning pointer that points to the new queue structure on success, NULL on error
+ * @note Items are kept in a pairing heap: O(1) push, peek and meld, amortized O(log n) pop.
+ *       Items pushed with priority_queue_push_handle() can be updated or erased later on.
+ *       Items of equal priority are not guaranteed to pop in insertion order.
+ */
+priority_queue_t *priority_queue_new_pairing(cmp_func_t compare)
+{
+    priority_queue_t *new_queue;
+
+    // Reserve memory for the new queue structure
+    new_queue = malloc(sizeof *new_queue);
+    if (new_queue != NULL)
+    {
+        // Also reserved memory for its internal representation
+        new_queue->backend = PRIORITY_QUEUE_PAIRING_HEAP;
+        new_queue->mem = NULL;
+        new_queue->heap = NULL;
+        new_queue->minmax = NULL;
+        new_queue->pairing = pairing_heap_new(compare);
+        new_queue->radix = NULL;
+        if (new_queue->pairing == NULL)
+        {
+            free(new_queue);
+            new_queue = NULL;
+        }
+        else
+        {
+            new_queue->compare = compare;
+            new_queue->sort = NULL;
+        }
+    }
+
+    // Return a pointer to the new queue structure
+#ifdef DEBUG
+    printf("Created pairing heap queue at %lx\n", (long unsigned int)new_queue);
+#endif
+    return new_queue;
+}
+
+/**
+ * @brief Radix heap priority queue constructor
+ * @param key_offset Offset in bytes of the unsigned 64-bit key within each item
+ * @return An owning pointer that points to the new queue structure on success, NULL on error
+ * @note Items with the smallest key have priority, no comparison function is involved. Amortized O(1)
+ *       push and pop, but pushed keys must not be smaller than the last popped key: pushing such an
+ *       item fails. Meant for monotone keys such as deadlines and timestamps.
+ *       Items of equal keys are not guaranteed to pop in insertion order.
+ */
+priority_queue_t *priority_queue_new_radix(size_t key_offset)
+{
+    priority_queue_t *new_queue;
+
+    // Reserve memory for the new queue structure
+    new_queue = malloc(sizeof *new_queue);
+    if (new_queue != NULL)
+    {
+        // Also reserved memory for its internal representation
+        new_queue->backend = PRIORITY_QUEUE_RADIX_HEAP;
+        new_queue->mem = NULL;
+        new_queue->heap = NULL;
+        new_queue->minmax = NULL;
+        new_queue->pairing = NULL;
+        new_queue->radix = radix_heap_new(key_offset);
+        if (new_queue->radix == NULL)
+        {
+            free(new_queue);
+            new_queue = NULL;
+        }
+        else
+        {
+            new_queue->compare = NULL;
+            new_queue->sort = NULL;
+        }
+    }
+
+    // Return a pointer to the new queue structure
+#ifdef DEBUG
+    printf("Created radix heap queue at %lx\n", (long unsigned int)new_queue);
+#endif
+    return new_queue;
+}
+
 /**
  * @brief Queue destructor
  * @param queue Pointer to the queue structure
@@ -52,6 +227,14 @@ void priority_queue_destroy(priority_queue_t *queue)
 #endif
         if (queue->mem != NULL)
             sorted_list_destroy(queue->mem);
+        if (queue->heap != NULL)
+            heap_destroy(queue->heap);
+        if (queue->minmax != NULL)
+            minmax_heap_destroy(queue->minmax);
+        if (queue->pairing != NULL)
+            pairing_heap_destroy(queue->pairing);
+        if (queue->radix != NULL)
+            radix_heap_destroy(queue->radix);
         free(queue);
 #ifdef DEBUG
         printf("Destroyed queue at %lx\n", (long unsigned int)queue);
@@ -66,7 +249,19 @@ void priority_queue_destroy(priority_queue_t *queue)
  */
 int priority_queue_empty(priority_queue_t *queue)
 {
-    return sorted_list_empty(queue->mem);
+    switch (queue->backend)
+    {
+    case PRIORITY_QUEUE_HEAP:
+        return heap_empty(queue->heap);
+    case PRIORITY_QUEUE_MINMAX_HEAP:
+        return minmax_heap_empty(queue->minmax);
+    case PRIORITY_QUEUE_PAIRING_HEAP:
+        return pairing_heap_empty(queue->pairing);
+    case PRIORITY_QUEUE_RADIX_HEAP:
+        return radix_heap_empty(queue->radix);
+    default:
+        return sorted_list_empty(queue->mem);
+    }
 }
 
 /**
@@ -76,7 +271,19 @@ int priority_queue_empty(priority_queue_t *queue)
  */
 size_t priority_queue_size(priority_queue_t *queue)
 {
-    return sorted_list_size(queue->mem);
+    switch (queue->backend)
+    {
+    case PRIORITY_QUEUE_HEAP:
+        return heap_size(queue->heap);
+    case PRIORITY_QUEUE_MINMAX_HEAP:
+        return minmax_heap_size(queue->minmax);
+    case PRIORITY_QUEUE_PAIRING_HEAP:
+        return pairing_heap_size(queue->pairing);
+    case PRIORITY_QUEUE_RADIX_HEAP:
+        return radix_heap_size(queue->radix);
+    default:
+        return sorted_list_size(queue->mem);
+    }
 }
 
 /**
@@ -88,7 +295,66 @@ size_t priority_queue_size(priority_queue_t *queue)
  */
 int priority_queue_push(priority_queue_t *queue, void *data, size_t data_size)
 {
-    return sorted_list_insert(queue->mem, data, data_size);
+    switch (queue->backend)
+    {
+    case PRIORITY_QUEUE_HEAP:
+        return heap_push(queue->heap, data, data_size);
+    case PRIORITY_QUEUE_MINMAX_HEAP:
+        return minmax_heap_push(queue->minmax, data, data_size);
+    case PRIORITY_QUEUE_PAIRING_HEAP:
+        return (pairing_heap_push(queue->pairing, data, data_size) != NULL) ? 0 : -1;
+    case PRIORITY_QUEUE_RADIX_HEAP:
+        return radix_heap_push(queue->radix, data, data_size);
+    default:
+        return sorted_list_insert(queue->mem, data, data_size);
+    }
+}
+
+/**
+ * @brief Push a new data item into a queue and get a handle to it
+ * @param queue Pointer to the queue structure
+ * @param data New data item
+ * @param data_size Size of data in bytes
+ * @return A handle to the new item on success, NULL on error or if the queue's backend has no stable handles
+ * @note Only pairing heap queues provide handles. A handle stays valid until its item is popped or erased
+ */
+node_t *priority_queue_push_handle(priority_queue_t *queue, void *data, size_t data_size)
+{
+    if (queue->backend != PRIORITY_QUEUE_PAIRING_HEAP)
+        return NULL;
+    return pairing_heap_push(queue->pairing, data, data_size);
+}
+
+/**
+ * @brief Reposition an item after its priority changed
+ * @param queue Pointer to the queue structure
+ * @param handle Handle of the item, as returned by priority_queue_push_handle()
+ * @return 0 on success, -1 on error
+ * @note The item's data may be modified in place through handle->data before calling this function.
+ *       Amortized O(log n)
+ */
+int priority_queue_update(priority_queue_t *queue, node_t *handle)
+{
+    if ((queue->backend != PRIORITY_QUEUE_PAIRING_HEAP) || (handle == NULL))
+        return -1;
+    pairing_heap_update(queue->pairing, handle);
+    return 0;
+}
+
+/**
+ * @brief Remove an item from a queue
+ * @param queue Pointer to the queue structure
+ * @param handle Handle of the item, as returned by priority_queue_push_handle()
+ * @param dest Destination
+ * @return 0 on success, -1 on error
+ * @note Amortized O(log n). The handle is invalid afterwards
+ */
+int priority_queue_erase(priority_queue_t *queue, node_t *handle, void *dest)
+{
+    if ((queue->backend != PRIORITY_QUEUE_PAIRING_HEAP) || (handle == NULL))
+        return -1;
+    pairing_heap_erase(queue->pairing, handle, dest);
+    return 0;
 }
 
 /**
@@ -99,7 +365,48 @@ int priority_queue_push(priority_queue_t *queue, void *data, size_t data_size)
 void priority_queue_pop(priority_queue_t *queue, void *dest)
 {
     // Default queue behavior is popping from the front
-    return sorted_list_pop_front(queue->mem, dest);
+    switch (queue->backend)
+    {
+    case PRIORITY_QUEUE_HEAP:
+        return heap_pop(queue->heap, dest);
+    case PRIORITY_QUEUE_MINMAX_HEAP:
+        return minmax_heap_pop_front(queue->minmax, dest);
+    case PRIORITY_QUEUE_PAIRING_HEAP:
+        return pairing_heap_pop(queue->pairing, dest);
+    case PRIORITY_QUEUE_RADIX_HEAP:
+        return radix_heap_pop(queue->radix, dest);
+    default:
+        return sorted_list_pop_front(queue->mem, dest);
+    }
+}
+
+/**
+ * @brief Pop the item with the lowest priority from a queue
+ * @param queue Pointer to the queue structure
+ * @param dest Destination
+ * @note O(log n) on min-max heap queues, O(1) on sorted list queues and O(n) on other queues
+ */
+void priority_queue_pop_back(priority_queue_t *queue, void *dest)
+{
+    node_t *back;
+
+    switch (queue->backend)
+    {
+    case PRIORITY_QUEUE_HEAP:
+        return heap_pop_back(queue->heap, dest);
+    case PRIORITY_QUEUE_MINMAX_HEAP:
+        return minmax_heap_pop_back(queue->minmax, dest);
+    case PRIORITY_QUEUE_PAIRING_HEAP:
+        // Pairing heaps have to look for their back node, then erase it
+        back = pairing_heap_back(queue->pairing);
+        if (back != NULL)
+            pairing_heap_erase(queue->pairing, back, dest);
+        return;
+    case PRIORITY_QUEUE_RADIX_HEAP:
+        return radix_heap_pop_back(queue->radix, dest);
+    default:
+        return sorted_list_pop_back(queue->mem, dest);
+    }
 }
 
 /**
@@ -111,7 +418,77 @@ void priority_queue_pop(priority_queue_t *queue, void *dest)
 int priority_queue_peek(priority_queue_t *queue, void *dest)
 {
     // Next item to be popped is at the front
-    return sorted_list_peek_front(queue->mem, dest);
+    switch (queue->backend)
+    {
+    case PRIORITY_QUEUE_HEAP:
+        return heap_peek(queue->heap, dest);
+    case PRIORITY_QUEUE_MINMAX_HEAP:
+        return minmax_heap_peek_front(queue->minmax, dest);
+    case PRIORITY_QUEUE_PAIRING_HEAP:
+        return pairing_heap_peek(queue->pairing, dest);
+    case PRIORITY_QUEUE_RADIX_HEAP:
+        return radix_heap_peek(queue->radix, dest);
+    default:
+        return sorted_list_peek_front(queue->mem, dest);
+    }
+}
+
+/**
+ * @brief Peek the item with the lowest priority in a queue
+ * @param queue Pointer to the queue structure
+ * @param dest Destination
+ * @return 0 on success, -1 on error
+ */
+int priority_queue_peek_back(priority_queue_t *queue, void *dest)
+{
+    node_t *back;
+
+    switch (queue->backend)
+    {
+    case PRIORITY_QUEUE_HEAP:
+    case PRIORITY_QUEUE_PAIRING_HEAP:
+    case PRIORITY_QUEUE_RADIX_HEAP:
+        // These heaps only expose their back node, copy it here
+        back = priority_queue_back(queue);
+        if ((back == NULL) || (dest == NULL))
+            return -1;
+        memcpy(dest, back->data, back->data_size);
+        return 0;
+    case PRIORITY_QUEUE_MINMAX_HEAP:
+        return minmax_heap_peek_back(queue->minmax, dest);
+    default:
+        return sorted_list_peek_back(queue->mem, dest);
+    }
+}
+
+/**
+ * @brief Get a pointer to the data of the next item to be popped from a queue
+ * @param queue Pointer to the queue structure
+ * @return A pointer to the item's data, NULL if the queue is empty
+ * @note The pointer is valid until the next push or pop. Fields the comparison function
+ *       depends on must not be modified through it.
+ */
+void *priority_queue_front_ptr(priority_queue_t *queue)
+{
+    node_t *front;
+
+    switch (queue->backend)
+    {
+    case PRIORITY_QUEUE_HEAP:
+        front = heap_front(queue->heap);
+        return (front != NULL) ? front->data : NULL;
+    case PRIORITY_QUEUE_MINMAX_HEAP:
+        front = minmax_heap_front(queue->minmax);
+        return (front != NULL) ? front->data : NULL;
+    case PRIORITY_QUEUE_PAIRING_HEAP:
+        front = pairing_heap_front(queue->pairing);
+        return (front != NULL) ? front->data : NULL;
+    case PRIORITY_QUEUE_RADIX_HEAP:
+        front = radix_heap_front(queue->radix);
+        return (front != NULL) ? front->data : NULL;
+    default:
+        return sorted_list_front_ptr(queue->mem);
+    }
 }
 
 /**
@@ -121,29 +498,50 @@ int priority_queue_peek(priority_queue_t *queue, void *dest)
  */
 node_t *priority_queue_front(priority_queue_t *queue)
 {
-    return queue->mem->head;
+    switch (queue->backend)
+    {
+    case PRIORITY_QUEUE_HEAP:
+        return heap_front(queue->heap);
+    case PRIORITY_QUEUE_MINMAX_HEAP:
+        return minmax_heap_front(queue->minmax);
+    case PRIORITY_QUEUE_PAIRING_HEAP:
+        return pairing_heap_front(queue->pairing);
+    case PRIORITY_QUEUE_RADIX_HEAP:
+        return radix_heap_front(queue->radix);
+    default:
+        return queue->mem->head;
+    }
 }
 
 /**
  * @brief Get a pointer to the last element in a queue
  * @param queue Pointer to the queue structure
- * @return A pointer to the bottom element in the queue structure
+ * @return A pointer to the bottom element in the queue structure, NULL if the queue is empty
+ * @note O(1) on sorted list and min-max heap queues, other queues have to scan part of their items
  */
 node_t *priority_queue_back(priority_queue_t *queue)
 {
-    node_t *iterator = NULL;
+    if (queue == NULL)
+        return NULL;
 
-    if (queue != NULL)
+    switch (queue->backend)
     {
-        // Find the last item on the list
-        iterator = queue->mem->head;
-        while (iterator->next != NULL)
-        {
-            iterator = iterator->next;
-        }
+    case PRIORITY_QUEUE_HEAP:
+        // The last item to be popped is one of the heap's leaves
+        return heap_back(queue->heap);
+    case PRIORITY_QUEUE_MINMAX_HEAP:
+        // The last item to be popped is the root or one of its children
+        return minmax_heap_back(queue->minmax);
+    case PRIORITY_QUEUE_PAIRING_HEAP:
+        // The last item to be popped is one of the heap's leaves
+        return pairing_heap_back(queue->pairing);
+    case PRIORITY_QUEUE_RADIX_HEAP:
+        // The last item to be popped is in the last non empty bucket
+        return radix_heap_back(queue->radix);
+    default:
+        // The last item to be popped is at the list's tail
+        return queue->mem->tail;
     }
-
-    return iterator;
 }
 
 /**
@@ -155,34 +553,152 @@ void priority_queue_clear(priority_queue_t *queue)
 #ifdef DEBUG
     printf("Clearing queue...\n");
 #endif
-    sorted_list_clear(queue->mem);
+    switch (queue->backend)
+    {
+    case PRIORITY_QUEUE_HEAP:
+        heap_clear(queue->heap);
+        break;
+    case PRIORITY_QUEUE_MINMAX_HEAP:
+        minmax_heap_clear(queue->minmax);
+        break;
+    case PRIORITY_QUEUE_PAIRING_HEAP:
+        pairing_heap_clear(queue->pairing);
+        break;
+    case PRIORITY_QUEUE_RADIX_HEAP:
+        radix_heap_clear(queue->radix);
+        break;
+    default:
+        sorted_list_clear(queue->mem);
+        break;
+    }
+}
+
+/**
+ * @brief Reorder a queue's container after it received new contents
+ * @param queue Pointer to the queue structure
+ * @note Contents already ordered by the queue's comparison function are left untouched.
+ *       Internal use only
+ */
+static void priority_queue_reorder(priority_queue_t *queue)
+{
+    // Radix heap queues have no comparison function to apply, any container keeps its order
+    if (queue->compare == NULL)
+        return;
+
+    switch (queue->backend)
+    {
+    case PRIORITY_QUEUE_HEAP:
+        // Rebuild the heap with the queue's comparison function in linear time, unless it already uses it
+        if (queue->heap->compare != queue->compare)
+            heap_rebuild(queue->heap, queue->compare);
+        return;
+    case PRIORITY_QUEUE_MINMAX_HEAP:
+        // Same for min-max heaps
+        if (queue->minmax->compare != queue->compare)
+            minmax_heap_rebuild(queue->minmax, queue->compare);
+        return;
+    case PRIORITY_QUEUE_PAIRING_HEAP:
+        // And for pairing heaps
+        if (queue->pairing->compare != queue->compare)
+            pairing_heap_rebuild(queue->pairing, queue->compare);
+        return;
+    case PRIORITY_QUEUE_RADIX_HEAP:
+        // Radix heaps are ordered by their keys
+        return;
+    default:
+        break;
+    }
+
+    // Keep the queue's sorting algorithm, a heap queue has no sorting algorithm to give
+    if (queue->sort != NULL)
+        queue->mem->sort = queue->sort;
+    if (queue->mem->compare == queue->compare)
+        return;
+
+    // Sort the queue using its comparison function and sorting algorithm
+    queue->mem->compare = queue->compare;
+    sorted_list_sort(queue->mem);
 }
 
 /**
  * @brief Exchanges the contents of two queues
  * @param queuea First queue
  * @param queueb Second queue
- * @note This function swaps the underlyinh containers of both queues
+ * @note This function swaps the underlyinh containers of both queues, each container keeps its backend.
+ *       Containers are only reordered if the queues' comparison functions differ. Radix heaps stay
+ *       ordered by their keys, and radix heap queues leave the container they receive as is.
  */
 void priority_queue_swap(priority_queue_t *queuea, priority_queue_t *queueb)
 {
+    priority_queue_backend_t temp_backend;
     sorted_list_t *temp;
+    heap_t *temp_heap;
+    minmax_heap_t *temp_minmax;
+    pairing_heap_t *temp_pairing;
+    radix_heap_t *temp_radix;
 
     // Swap the underlying containers
+    temp_backend = queuea->backend;
+    queuea->backend = queueb->backend;
+    queueb->backend = temp_backend;
     temp = queuea->mem;
     queuea->mem = queueb->mem;
     queueb->mem = temp;
+    temp_heap = queuea->heap;
+    queuea->heap = queueb->heap;
+    queueb->heap = temp_heap;
+    temp_minmax = queuea->minmax;
+    queuea->minmax = queueb->minmax;
+    queueb->minmax = temp_minmax;
+    temp_pairing = queuea->pairing;
+    queuea->pairing = queueb->pairing;
+    queueb->pairing = temp_pairing;
+    temp_radix = queuea->radix;
+    queuea->radix = queueb->radix;
+    queueb->radix = temp_radix;
 
-    // Update the container's comparison and sorting functions
-    queuea->mem->compare = queuea->compare;
-    queueb->mem->compare = queueb->compare;
-    queuea->mem->sort = queuea->sort;
-    queueb->mem->sort = queueb->sort;
-
-    // Sort the queues using their comparison functions and sorting algorithms
-    queuea->mem->sort(&queuea->mem->head, queuea->compare);
-    queueb->mem->sort(&queueb->mem->head, queueb->compare);
+    // Reorder the containers according to each queue's priority scheme
+    priority_queue_reorder(queuea);
+    priority_queue_reorder(queueb);
 #ifdef DEBUG
     printf("Swapped contents of queue at %lx and queue at %lx\n", (long unsigned int)queuea, (long unsigned int)queueb);
 #endif
 }
+
+/**
+ * @brief Move all items of a queue into another one
+ * @param dest Pointer to the queue structure receiving the items
+ * @param src Pointer to the queue structure giving its items, left empty
+ * @return 0 on success, -1 on error
+ * @note O(1) between pairing heap queues with the same comparison function, in which case handles to
+ *       src's items stay valid. Otherwise src's items are pushed into dest one by one.
+ */
+int priority_queue_meld(priority_queue_t *dest, priority_queue_t *src)
+{
+    node_t *front;
+
+    if (dest == src)
+        return 0;
+
+    // Pairing heaps link their roots
+    if ((dest->backend == PRIORITY_QUEUE_PAIRING_HEAP) && (src->backend == PRIORITY_QUEUE_PAIRING_HEAP))
+    {
+        pairing_heap_meld(dest->pairing, src->pairing);
+#ifdef DEBUG
+        printf("Melded queue at %lx into queue at %lx\n", (long unsigned int)src, (long unsigned int)dest);
+#endif
+        return 0;
+    }
+
+    // Any other pair of backends goes through push and pop
+    while ((front = priority_queue_front(src)) != NULL)
+    {
+        if (priority_queue_push(dest, front->data, front->data_size) != 0)
+            return -1;
+        priority_queue_pop(src, NULL);
+    }
+#ifdef DEBUG
+    printf("Melded queue at %lx into queue at %lx\n", (long unsigned int)src, (long unsigned int)dest);
+#endif
+    return 0;
+}
@@ -2,24 +2,53 @@
 #define _PRIORITY_QUEUE_H
 
 #include "sorted_list.h"
+#include "heap.h"
+#include "minmax_heap.h"
+#include "pairing_heap.h"
+#include "radix_heap.h"
+
+typedef enum priority_queue_backend
+{
+    PRIORITY_QUEUE_SORTED_LIST,
+    PRIORITY_QUEUE_HEAP,
+    PRIORITY_QUEUE_MINMAX_HEAP,
+    PRIORITY_QUEUE_PAIRING_HEAP,
+    PRIORITY_QUEUE_RADIX_HEAP
+} priority_queue_backend_t;
 
 typedef struct priority_queue
 {
+    priority_queue_backend_t backend;
     sorted_list_t * mem;
+    heap_t * heap;
+    minmax_heap_t * minmax;
+    pairing_heap_t * pairing;
+    radix_heap_t * radix;
     cmp_func_t compare;
     sort_func_t sort;
 } priority_queue_t;
 
 priority_queue_t *priority_queue_new(cmp_func_t compare, sort_func_t sort);
+priority_queue_t *priority_queue_new_heap(cmp_func_t compare);
+priority_queue_t *priority_queue_new_minmax(cmp_func_t compare);
+priority_queue_t *priority_queue_new_pairing(cmp_func_t compare);
+priority_queue_t *priority_queue_new_radix(size_t key_offset);
 void priority_queue_destroy(priority_queue_t* queue);
 int priority_queue_empty(priority_queue_t* queue);
 size_t priority_queue_size(priority_queue_t* queue);
 int priority_queue_push(priority_queue_t* queue, void *data, size_t data_size);
+node_t *priority_queue_push_handle(priority_queue_t* queue, void *data, size_t data_size);
+int priority_queue_update(priority_queue_t* queue, node_t *handle);
+int priority_queue_erase(priority_queue_t* queue, node_t *handle, void *dest);
 void priority_queue_pop(priority_queue_t* queue, void *dest);
+void priority_queue_pop_back(priority_queue_t* queue, void *dest);
 int priority_queue_peek(priority_queue_t* queue, void *dest);
+int priority_queue_peek_back(priority_queue_t* queue, void *dest);
+void *priority_queue_front_ptr(priority_queue_t* queue);
 node_t *priority_queue_front(priority_queue_t* queue);
 node_t *priority_queue_back(priority_queue_t* queue);
 void priority_queue_clear(priority_queue_t* queue);
 void priority_queue_swap(priority_queue_t* queuea, priority_queue_t* queueb);
+int priority_queue_meld(priority_queue_t* dest, priority_queue_t* src);
 
 #endif
\ No newline at end of file
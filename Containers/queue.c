@@ -5,6 +5,8 @@
 #include <stdio.h>
 #endif
 
+#define QUEUE_MIN_CAPACITY 16
+
 /**
  * @brief Queue constructor
  * @return An owning pointer that points to the new queue structure on success, NULL on error 
@@ -18,6 +20,7 @@ queue_t *queue_new()
     if (new_queue != NULL)
     {
         // Also reserved memory for its internal representation
+        *new_queue = (queue_t){ 0 };
         new_queue->mem = list_new();
         if (new_queue->mem == NULL)
         {
@@ -33,6 +36,162 @@ queue_t *queue_new()
     return new_queue;
 }
 
+/**
+ * @brief Pooled queue constructor
+ * @param data_size Size of the datatype the queue is expected to store in bytes
+ * @param nodes_per_slab Number of nodes reserved at once when the pool runs dry, 0 for a default
+ * @return An owning pointer that points to the new queue structure on success, NULL on error
+ * @note Nodes are recycled through a pool owned by the queue's internal representation
+ */
+queue_t *queue_new_pooled(size_t data_size, size_t nodes_per_slab)
+{
+    queue_t *new_queue;
+    
+    // Reserve memory for the new queue structure
+    new_queue = malloc(sizeof *new_queue);
+    if (new_queue != NULL)
+    {
+        // Also reserved memory for its internal representation, backed by a node pool
+        *new_queue = (queue_t){ 0 };
+        new_queue->mem = list_new_pooled(data_size, nodes_per_slab);
+        if (new_queue->mem == NULL)
+        {
+            free(new_queue);
+            new_queue = NULL;
+        }
+    }
+
+    // Return a pointer to the new queue structure
+#ifdef DEBUG
+    printf("Created pooled queue at %lx\n", (long unsigned int)new_queue);
+#endif
+    return new_queue;
+}
+
+/**
+ * @brief Constructor for a queue sharing another queue's node pool
+ * @param other Pointer to the list-backed queue structure whose pool is shared
+ * @return An owning pointer that points to the new queue structure on success, NULL on error
+ * @note Queues sharing a pool transfer their items in O(1), see queue_transfer()
+ */
+queue_t *queue_new_shared(queue_t *other)
+{
+    queue_t *new_queue;
+
+    // Fixed-size queues have no nodes to share
+    if ((other == NULL) || (other->mem == NULL))
+        return NULL;
+
+    // Reserve memory for the new queue structure
+    new_queue = malloc(sizeof *new_queue);
+    if (new_queue != NULL)
+    {
+        // Also reserved memory for its internal representation, backed by the other queue's pool
+        *new_queue = (queue_t){ 0 };
+        new_queue->mem = list_new_shared(other->mem);
+        if (new_queue->mem == NULL)
+        {
+            free(new_queue);
+            new_queue = NULL;
+        }
+    }
+
+    // Return a pointer to the new queue structure
+#ifdef DEBUG
+    printf("Created queue at %lx sharing the pool of queue at %lx\n", (long unsigned int)new_queue, (long unsigned int)other);
+#endif
+    return new_queue;
+}
+
+/**
+ * @brief Fixed-size item queue constructor
+ * @param elem_size Size of every item the queue stores in bytes
+ * @param capacity_hint Number of items to reserve room for up front, 0 for a default
+ * @return An owning pointer that points to the new queue structure on success, NULL on error
+ * @note Items are stored inline in a ring buffer with power-of-two capacity that doubles when full.
+ *       queue_front() and queue_back() return NULL on such queues, as there are no nodes.
+ */
+queue_t *queue_new_fixed(size_t elem_size, size_t capacity_hint)
+{
+    queue_t *new_queue;
+    size_t capacity = QUEUE_MIN_CAPACITY;
+
+    if (elem_size == 0)
+        return NULL;
+
+    // Round the capacity up to a power of two so indices wrap with a mask
+    while (capacity < capacity_hint)
+    {
+        capacity <<= 1;
+    }
+
+    // Reserve memory for the new queue structure
+    new_queue = malloc(sizeof *new_queue);
+    if (new_queue != NULL)
+    {
+        // Also reserved memory for its ring buffer
+        *new_queue = (queue_t){ 0 };
+        new_queue->ring = malloc(capacity * elem_size);
+        if (new_queue->ring == NULL)
+        {
+            free(new_queue);
+            new_queue = NULL;
+        }
+        else
+        {
+            new_queue->elem_size = elem_size;
+            new_queue->capacity = capacity;
+        }
+    }
+
+    // Return a pointer to the new queue structure
+#ifdef DEBUG
+    printf("Created fixed-size queue at %lx\n", (long unsigned int)new_queue);
+#endif
+    return new_queue;
+}
+
+/**
+ * @brief Double the capacity of a queue's ring buffer
+ * @param queue Pointer to the queue structure
+ * @return 0 on success, -1 on error
+ * @note Internal use only
+ */
+static int queue_grow(queue_t *queue)
+{
+    unsigned char *ring;
+    size_t first;
+
+    ring = malloc(2 * queue->capacity * queue->elem_size);
+    if (ring == NULL)
+        return -1;
+
+    // Unwrap the items so the front lands at the start of the new buffer
+    first = queue->capacity - queue->head;
+    if (first > queue->count)
+        first = queue->count;
+    memcpy(ring, queue->ring + queue->head * queue->elem_size, first * queue->elem_size);
+    memcpy(ring + first * queue->elem_size, queue->ring, (queue->count - first) * queue->elem_size);
+
+    free(queue->ring);
+    queue->ring = ring;
+    queue->capacity *= 2;
+    queue->head = 0;
+    return 0;
+}
+
+/**
+ * @brief Get a pointer to an item in a queue's ring buffer
+ * @param queue Pointer to the queue structure
+ * @param position Position of the item counting from the front
+ * @return A pointer to the item
+ * @note Internal use only
+ */
+static unsigned char *queue_slot(queue_t *queue, size_t position)
+{
+    return queue->ring + ((queue->head + position) & (queue->capacity - 1)) * queue->elem_size;
+}
+
 /**
  * @brief Queue destructor
  * @param queue Pointer to the queue structure
@@ -47,6 +206,7 @@ void queue_destroy(queue_t *queue)
 #endif
         if (queue->mem != NULL)
             list_destroy(queue->mem);
+        free(queue->ring);
         free(queue);
 #ifdef DEBUG
         printf("Destroyed queue at %lx\n", (long unsigned int)queue);
@@ -61,6 +221,8 @@ void queue_destroy(queue_t *queue)
  */
 int queue_empty(queue_t *queue)
 {
+    if (queue->mem == NULL)
+        return (queue->count == 0) ? 1 : 0;
     return list_empty(queue->mem);
 }
 
@@ -71,6 +233,8 @@ int queue_empty(queue_t *queue)
  */
 size_t queue_size(queue_t *queue)
 {
+    if (queue->mem == NULL)
+        return queue->count;
     return list_size(queue->mem);
 }
 
@@ -80,11 +244,68 @@ size_t queue_size(queue_t *queue)
  * @param data New data item
  * @param data_size Size of data in bytes
  * @return 0 on success, -1 on error
+ * @note Fixed-size queues only accept items of their own size
  */
 int queue_push(queue_t *queue, void *data, size_t data_size)
 {
+    void *dest;
+
+    if (data == NULL)
+        return -1;
+
+    // Reserve the new item in place, then fill it
+    dest = queue_emplace(queue, data_size);
+    if (dest == NULL)
+        return -1;
+    memcpy(dest, data, data_size);
+
+    return 0;
+}
+
+/**
+ * @brief Push an uninitialized data item onto a queue
+ * @param queue Pointer to the queue structure
+ * @param data_size Size of the new item in bytes
+ * @return A pointer to the new item for the caller to fill, NULL on error
+ * @note Fixed-size queues only accept items of their own size
+ */
+void *queue_emplace(queue_t *queue, size_t data_size)
+{
+    if (queue->mem == NULL)
+    {
+        if (data_size != queue->elem_size)
+            return NULL;
+        if ((queue->count == queue->capacity) && (queue_grow(queue) != 0))
+            return NULL;
+
+        // Hand out the slot after the back of the ring
+        return queue_slot(queue, queue->count++);
+    }
+
+    // Default queue behavior is pushing to the back
+    return list_emplace_back(queue->mem, data_size);
+}
+
+/**
+ * @brief Push a heap buffer onto a queue without copying it
+ * @param queue Pointer to the queue structure
+ * @param data Buffer obtained from malloc, owned by the queue on success
+ * @param data_size Size of the buffer in bytes
+ * @return 0 on success, -1 on error, in which case the caller keeps ownership of data
+ * @note Fixed-size queues store items inline, so they copy the item and free the buffer
+ */
+int queue_push_owned(queue_t *queue, void *data, size_t data_size)
+{
+    if (queue->mem == NULL)
+    {
+        if (queue_push(queue, data, data_size) != 0)
+            return -1;
+        free(data);
+        return 0;
+    }
+
     // Default queue behavior is pushing to the back
-    return list_push_back(queue->mem, data, data_size);
+    return list_push_back_owned(queue->mem, data, data_size);
 }
 
 /**
@@ -94,10 +315,53 @@ int queue_push(queue_t *queue, void *data, size_t data_size)
  */
 void queue_pop(queue_t *queue, void *dest)
 {
+    if (queue->mem == NULL)
+    {
+        if (queue->count == 0)
+            return;
+
+        // Data from the front slot is copied into destination if provided
+        if (dest != NULL)
+            memcpy(dest, queue_slot(queue, 0), queue->elem_size);
+        queue->head = (queue->head + 1) & (queue->capacity - 1);
+        queue->count--;
+        return;
+    }
+
     // Default queue behavior is popping from the front
     return list_pop_front(queue->mem, dest);
 }
 
+/**
+ * @brief Pop a data item from a queue as a heap buffer
+ * @param queue Pointer to the queue structure
+ * @param data_size Destination for the size of the item in bytes, may be NULL
+ * @return A buffer holding the item that the caller must free, NULL if the queue is empty or on error
+ * @note Buffers adopted by queue_push_owned() are returned without copying
+ */
+void *queue_pop_owned(queue_t *queue, size_t *data_size)
+{
+    void *data;
+
+    if (queue->mem == NULL)
+    {
+        if (queue->count == 0)
+            return NULL;
+
+        // Inline items have to move into a buffer of their own
+        data = malloc(queue->elem_size);
+        if (data == NULL)
+            return NULL;
+        queue_pop(queue, data);
+        if (data_size != NULL)
+            *data_size = queue->elem_size;
+        return data;
+    }
+
+    // Default queue behavior is popping from the front
+    return list_pop_front_owned(queue->mem, data_size);
+}
+
 /**
  * @brief Peek the last item pushed onto a queue
  * @param queue Pointer to the queue structure
@@ -106,27 +370,67 @@ void queue_pop(queue_t *queue, void *dest)
  */
 int queue_peek(queue_t *queue, void *dest)
 {
+    if (queue->mem == NULL)
+    {
+        if ((queue->count == 0) || (dest == NULL))
+            return -1;
+
+        // Copy peeked data into its destination
+        memcpy(dest, queue_slot(queue, 0), queue->elem_size);
+        return 0;
+    }
+
     // Last item pushed is at the front
     return list_peek_front(queue->mem, dest);
 }
 
+/**
+ * @brief Get a pointer to the data of the next element in a queue
+ * @param queue Pointer to the queue structure
+ * @return A pointer to the item, NULL if the queue is empty
+ * @note The pointer is valid until the next push or pop
+ */
+void *queue_front_ptr(queue_t *queue)
+{
+    if (queue->mem == NULL)
+        return (queue->count != 0) ? queue_slot(queue, 0) : NULL;
+    return list_front_ptr(queue->mem);
+}
+
+/**
+ * @brief Get a pointer to the data of the last element in a queue
+ * @param queue Pointer to the queue structure
+ * @return A pointer to the item, NULL if the queue is empty
+ * @note The pointer is valid until the next push or pop
+ */
+void *queue_back_ptr(queue_t *queue)
+{
+    if (queue->mem == NULL)
+        return (queue->count != 0) ? queue_slot(queue, queue->count - 1) : NULL;
+    return list_back_ptr(queue->mem);
+}
+
 /**
  * @brief Get a pointer to the next element in a queue
  * @param queue Pointer to the queue structure
- * @return A pointer to the top element in the queue structure
+ * @return A pointer to the top element in the queue structure, NULL for fixed-size queues
  */
 node_t *queue_front(queue_t *queue)
 {
+    if (queue->mem == NULL)
+        return NULL;
     return queue->mem->head;
 }
 
 /**
  * @brief Get a pointer to the last element in a queue
  * @param queue Pointer to the queue structure
- * @return A pointer to the bottom element in the queue structure
+ * @return A pointer to the bottom element in the queue structure, NULL for fixed-size queues
  */
 node_t *queue_back(queue_t *queue)
 {
+    if (queue->mem == NULL)
+        return NULL;
     return queue->mem->tail;
 }
 
@@ -139,6 +443,13 @@ void queue_clear(queue_t *queue)
 #ifdef DEBUG
     printf("Clearing queue...\n");
 #endif
+    if (queue->mem == NULL)
+    {
+        // The ring buffer is kept for reuse
+        queue->head = 0;
+        queue->count = 0;
+        return;
+    }
     list_clear(queue->mem);
 }
 
@@ -150,11 +461,64 @@ void queue_clear(queue_t *queue)
  */
 void queue_swap(queue_t *queuea, queue_t *queueb)
 {
-    list_t *temp;
-    temp = queuea->mem;
-    queuea->mem = queueb->mem;
-    queueb->mem = temp;
+    queue_t temp;
+    temp = *queuea;
+    *queuea = *queueb;
+    *queueb = temp;
 #ifdef DEBUG
     printf("Swapped contents of queue at %lx and queue at %lx\n", (long unsigned int)queuea, (long unsigned int)queueb);
 #endif
 }
+
+/**
+ * @brief Move every item of a queue to the back of another one
+ * @param dest Pointer to the destination queue structure
+ * @param src Pointer to the source queue structure, left empty
+ * @return 0 on success, -1 on error
+ * @note List-backed queues relink their nodes in O(1), and must share the same node pool,
+ *       see queue_new_shared(), or have none. Fixed-size queues must store items of the same size,
+ *       and copy them unless the destination is empty. A list-backed and a fixed-size queue can't be mixed.
+ */
+int queue_transfer(queue_t *dest, queue_t *src)
+{
+    size_t i;
+
+    if ((dest == NULL) || (src == NULL) || (dest == src))
+        return -1;
+    if ((dest->mem != NULL) && (src->mem != NULL))
+        return list_concat(dest->mem, src->mem);
+    if ((dest->mem != NULL) || (src->mem != NULL) || (dest->elem_size != src->elem_size))
+        return -1;
+
+    // An empty destination simply takes over the source's ring
+    if (dest->count == 0)
+    {
+        queue_swap(dest, src);
+        return 0;
+    }
+
+    // Otherwise make room for every item at once, then copy them in order
+    while (dest->capacity - dest->count < src->count)
+    {
+        if (queue_grow(dest) != 0)
+            return -1;
+    }
+    for (i = 0; i < src->count; i++)
+        memcpy(queue_slot(dest, dest->count + i), queue_slot(src, i), src->elem_size);
+    dest->count += src->count;
+    src->head = 0;
+    src->count = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Get the allocation counters of a pooled queue
+ * @param queue Pointer to the queue structure
+ * @param dest Destination
+ * @return 0 on success, -1 if the queue has no pool
+ */
+int queue_pool_stats(queue_t *queue, node_pool_stats_t *dest)
+{
+    return list_pool_stats(queue->mem, dest);
+}
@@ -6,18 +6,33 @@
 typedef struct queue
 {
     list_t * mem;
+    unsigned char *ring;
+    size_t elem_size;
+    size_t capacity;
+    size_t head;
+    size_t count;
 } queue_t;
 
 queue_t *queue_new();
+queue_t *queue_new_pooled(size_t data_size, size_t nodes_per_slab);
+queue_t *queue_new_shared(queue_t *other);
+queue_t *queue_new_fixed(size_t elem_size, size_t capacity_hint);
 void queue_destroy(queue_t *queue);
 int queue_empty(queue_t *queue);
 size_t queue_size(queue_t *queue);
 int queue_push(queue_t *queue, void *data, size_t data_size);
+void *queue_emplace(queue_t *queue, size_t data_size);
+int queue_push_owned(queue_t *queue, void *data, size_t data_size);
 void queue_pop(queue_t *queue, void *dest);
+void *queue_pop_owned(queue_t *queue, size_t *data_size);
 int queue_peek(queue_t *queue, void *dest);
+void *queue_front_ptr(queue_t *queue);
+void *queue_back_ptr(queue_t *queue);
 node_t *queue_front(queue_t *queue);
 node_t *queue_back(queue_t *queue);
 void queue_clear(queue_t *queue);
 void queue_swap(queue_t *queuea, queue_t *queueb);
+int queue_transfer(queue_t *dest, queue_t *src);
+int queue_pool_stats(queue_t *queue, node_pool_stats_t *dest);
 
 #endif
\ No newline at end of file
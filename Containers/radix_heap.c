@@ -0,0 +1,482 @@
+#include "radix_heap.h"
+#include <string.h>
+#ifdef DEBUG
+#include <stdio.h>
+#endif
+
+#define RADIX_HEAP_INITIAL_CAPACITY 16
+
+/**
+ * @brief Node constructor
+ * @param data Data to be stored within the new node
+ * @param data_size Size of the datatype stored within the new node in bytes
+ * @return An owning pointer that points to the new node
+ * @note Internal use only
+ */
+static node_t *node_new(void *data, size_t data_size)
+{
+    node_t *new_node;
+
+    // Reserve memory for the new node and its encapsulated data in a single block
+    new_node = malloc(sizeof *new_node + data_size);
+    if (new_node != NULL)
+    {
+        // Initialize the structure, heap nodes are never chained
+        new_node->data = new_node->payload;
+        memcpy(new_node->data, data, data_size);
+        new_node->data_size = data_size;
+        new_node->next = NULL;
+    }
+
+    return new_node;
+}
+
+/**
+ * @brief Find the bucket an item belongs to
+ * @param key Key of the item
+ * @param last Last popped key, not greater than key
+ * @return 0 if both keys are equal, otherwise the position of the highest bit where they differ, plus one
+ * @note Internal use only
+ */
+static int bucket_index(uint64_t key, uint64_t last)
+{
+    uint64_t diff = key ^ last;
+    int index = 0;
+
+    if (diff == 0)
+        return 0;
+#if defined(__GNUC__)
+    index = 64 - __builtin_clzll(diff);
+#else
+    while (diff != 0)
+    {
+        diff >>= 1;
+        index++;
+    }
+#endif
+    return index;
+}
+
+/**
+ * @brief Make room for a number of entries in a bucket
+ * @param bucket Pointer to the bucket
+ * @param needed Number of entries the bucket must be able to hold
+ * @return 0 on success, -1 on error
+ * @note Internal use only
+ */
+static int bucket_reserve(radix_bucket_t *bucket, size_t needed)
+{
+    radix_entry_t *entries;
+    size_t capacity;
+
+    if (needed <= bucket->capacity)
+        return 0;
+
+    // Grow the entry array geometrically, it is kept once the bucket empties
+    capacity = (bucket->capacity != 0) ? bucket->capacity : RADIX_HEAP_INITIAL_CAPACITY;
+    while (capacity < needed)
+    {
+        capacity *= 2;
+    }
+    entries = realloc(bucket->entries, capacity * sizeof *entries);
+    if (entries == NULL)
+        return -1;
+    bucket->entries = entries;
+    bucket->capacity = capacity;
+
+    return 0;
+}
+
+/**
+ * @brief Find the first non empty bucket past the one holding items equal to the last popped key
+ * @param heap Pointer to the heap structure
+ * @return Index of the bucket
+ * @note The heap must contain items outside of bucket 0. Internal use only
+ */
+static int first_bucket(radix_heap_t *heap)
+{
+    int i = 1;
+
+    while (heap->buckets[i].size == 0)
+    {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * @brief Find the position of the smallest key in a bucket
+ * @param bucket Pointer to the bucket, which must not be empty
+ * @return Position of the entry
+ * @note Internal use only
+ */
+static size_t bucket_min(radix_bucket_t *bucket)
+{
+    size_t best = 0;
+    size_t i;
+
+    for (i = 1; i < bucket->size; i++)
+    {
+        if (bucket->entries[i].key < bucket->entries[best].key)
+            best = i;
+    }
+    return best;
+}
+
+/**
+ * @brief Find the item with the largest key in a heap
+ * @param heap Pointer to the heap structure, which must not be empty
+ * @param bucket_ref Destination for the bucket holding the item
+ * @return Position of the entry within its bucket
+ * @note Only the last non empty bucket is scanned. Internal use only
+ */
+static size_t back_position(radix_heap_t *heap, radix_bucket_t **bucket_ref)
+{
+    radix_bucket_t *bucket;
+    size_t best = 0;
+    size_t i;
+    int index;
+
+    // The largest key is in the last non empty bucket
+    index = RADIX_HEAP_BUCKETS - 1;
+    while (heap->buckets[index].size == 0)
+    {
+        index--;
+    }
+    bucket = &heap->buckets[index];
+    best = 0;
+    for (i = 1; i < bucket->size; i++)
+    {
+        if (bucket->entries[i].key > bucket->entries[best].key)
+            best = i;
+    }
+
+    *bucket_ref = bucket;
+    return best;
+}
+
+/**
+ * @brief Move the items with the smallest keys into bucket 0
+ * @param heap Pointer to the heap structure
+ * @return 0 on success, -1 on error
+ * @note Every item of the first non empty bucket moves to a lower bucket, which is what makes
+ *       pops amortized O(1): an item can only move down 64 times. Internal use only
+ */
+static int redistribute(radix_heap_t *heap)
+{
+    size_t counts[RADIX_HEAP_BUCKETS] = { 0 };
+    radix_bucket_t *source;
+    radix_bucket_t *target;
+    uint64_t last;
+    size_t i;
+    int index;
+
+    source = &heap->buckets[first_bucket(heap)];
+    last = source->entries[bucket_min(source)].key;
+
+    // Reserve room in the target buckets first, so that a failure leaves the heap untouched
+    for (i = 0; i < source->size; i++)
+    {
+        counts[bucket_index(source->entries[i].key, last)]++;
+    }
+    for (index = 0; index < RADIX_HEAP_BUCKETS; index++)
+    {
+        if ((counts[index] != 0) && (bucket_reserve(&heap->buckets[index], heap->buckets[index].size + counts[index]) != 0))
+            return -1;
+    }
+
+    // All items of the source bucket go to lower buckets
+    heap->last = last;
+    for (i = 0; i < source->size; i++)
+    {
+        target = &heap->buckets[bucket_index(source->entries[i].key, last)];
+        target->entries[target->size++] = source->entries[i];
+    }
+    source->size = 0;
+    heap->front = NULL;
+
+    return 0;
+}
+
+/**
+ * @brief Radix heap constructor
+ * @param key_offset Offset in bytes of the unsigned 64-bit key within each item
+ * @return An owning pointer that points to the new heap on success, NULL on error
+ */
+radix_heap_t *radix_heap_new(size_t key_offset)
+{
+    radix_heap_t *new_heap;
+    int i;
+
+    // Reserve memory for the new heap structure, buckets reserve their entries on demand
+    new_heap = malloc(sizeof *new_heap);
+    if (new_heap != NULL)
+    {
+        for (i = 0; i < RADIX_HEAP_BUCKETS; i++)
+        {
+            new_heap->buckets[i].entries = NULL;
+            new_heap->buckets[i].size = 0;
+            new_heap->buckets[i].capacity = 0;
+        }
+        new_heap->last = 0;
+        new_heap->size = 0;
+        new_heap->key_offset = key_offset;
+        new_heap->front = NULL;
+        new_heap->front_key = 0;
+    }
+
+    // Return a pointer to the new heap structure
+#ifdef DEBUG
+    printf("Created radix heap at %lx\n", (unsigned long int)new_heap);
+#endif
+    return new_heap;
+}
+
+/**
+ * @brief Radix heap destructor
+ * @param heap Pointer to the heap structure to be destroyed
+ */
+void radix_heap_destroy(radix_heap_t *heap)
+{
+    int i;
+
+    if (heap != NULL)
+    {
+        // Destroy all nodes before freeing the memory allocated to the heap structure
+        radix_heap_clear(heap);
+        for (i = 0; i < RADIX_HEAP_BUCKETS; i++)
+        {
+            free(heap->buckets[i].entries);
+        }
+        free(heap);
+#ifdef DEBUG
+        printf("Destroyed radix heap at %lx\n", (unsigned long int)heap);
+#endif
+    }
+}
+
+/**
+ * @brief Check if a heap contains no items
+ * @param heap Pointer to the heap structure
+ * @return 1 for empty, 0 otherwise
+ */
+int radix_heap_empty(radix_heap_t *heap)
+{
+    return (heap->size == 0) ? 1 : 0;
+}
+
+/**
+ * @brief Check the number of items a heap contains
+ * @param heap Pointer to the heap structure
+ * @return Number of items contained in the heap
+ */
+size_t radix_heap_size(radix_heap_t *heap)
+{
+    return heap->size;
+}
+
+/**
+ * @brief Insert an item into a heap
+ * @param heap Pointer to the heap structure
+ * @param data Data to be stored within the new item
+ * @param data_size Size of data in bytes
+ * @return 0 on success, -1 on error
+ * @note Keys must not be smaller than the last popped key, such items are rejected. O(1)
+ */
+int radix_heap_push(radix_heap_t *heap, void *data, size_t data_size)
+{
+    radix_bucket_t *bucket;
+    node_t *new_item;
+    uint64_t key;
+    int index;
+
+    // The item must hold a key, which must not be in the past
+    if ((data == NULL) || (data_size < heap->key_offset + sizeof key))
+        return -1;
+    memcpy(&key, (unsigned char *)data + heap->key_offset, sizeof key);
+    if (key < heap->last)
+        return -1;
+
+    // Make room for the entry before creating its node
+    index = bucket_index(key, heap->last);
+    bucket = &heap->buckets[index];
+    if (bucket_reserve(bucket, bucket->size + 1) != 0)
+        return -1;
+    new_item = node_new(data, data_size);
+    if (new_item == NULL)
+        return -1;
+
+    bucket->entries[bucket->size].key = key;
+    bucket->entries[bucket->size].node = new_item;
+    bucket->size++;
+    heap->size++;
+
+    // The cached front only stands for the first non empty bucket while bucket 0 is empty
+    if (index == 0)
+        heap->front = NULL;
+    else if ((heap->front != NULL) && (key < heap->front_key))
+    {
+        heap->front = new_item;
+        heap->front_key = key;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Extract the item with the smallest key from a heap
+ * @param heap Pointer to the heap structure
+ * @param dest Destination
+ * @note Amortized O(1). Nothing is popped if the heap could not reserve memory to move items around
+ */
+void radix_heap_pop(radix_heap_t *heap, void *dest)
+{
+    radix_bucket_t *bucket;
+    node_t *popped_node;
+
+    // The heap must exist and have at least one item to pop
+    if ((heap == NULL) || (heap->size == 0))
+        return;
+
+    bucket = &heap->buckets[0];
+    // Items with the smallest key are brought to bucket 0 when it runs empty
+    if ((bucket->size == 0) && (redistribute(heap) != 0))
+        return;
+
+    popped_node = bucket->entries[--bucket->size].node;
+    heap->size--;
+
+    // Data from the popped node is copied into destination if provided
+    if (dest != NULL)
+    {
+        memcpy(dest, popped_node->data, popped_node->data_size);
+    }
+    // Finally, the popped node is destroyed
+    free(popped_node);
+}
+
+/**
+ * @brief Extract the item with the largest key from a heap
+ * @param heap Pointer to the heap structure
+ * @param dest Destination
+ * @note Only the last non empty bucket is scanned, but this is still O(n)
+ */
+void radix_heap_pop_back(radix_heap_t *heap, void *dest)
+{
+    radix_bucket_t *bucket;
+    node_t *popped_node;
+    size_t best;
+
+    // The heap must exist and have at least one item to pop
+    if ((heap == NULL) || (heap->size == 0))
+        return;
+
+    // Order within a bucket doesn't matter, the last entry fills the gap
+    best = back_position(heap, &bucket);
+    popped_node = bucket->entries[best].node;
+    bucket->entries[best] = bucket->entries[--bucket->size];
+    heap->size--;
+    if (popped_node == heap->front)
+        heap->front = NULL;
+
+    // Data from the popped node is copied into destination if provided
+    if (dest != NULL)
+    {
+        memcpy(dest, popped_node->data, popped_node->data_size);
+    }
+    // Finally, the popped node is destroyed
+    free(popped_node);
+}
+
+/**
+ * @brief Peek the item with the smallest key in a heap
+ * @param heap Pointer to the heap structure
+ * @param dest Destination
+ * @return 0 on success, -1 on error
+ */
+int radix_heap_peek(radix_heap_t *heap, void *dest)
+{
+    node_t *front = radix_heap_front(heap);
+
+    if ((front != NULL) && (dest != NULL))
+    {
+        // Copy peeked data into its destination
+        memcpy(dest, front->data, front->data_size);
+        return 0;
+    }
+    return -1;
+}
+
+/**
+ * @brief Get a pointer to the item with the smallest key in a heap
+ * @param heap Pointer to the heap structure
+ * @return A pointer to the node, NULL if the heap is empty
+ * @note Peeking doesn't move items around, so it doesn't restrict the keys that can be pushed.
+ *       The first non empty bucket is scanned once, then the result is cached until the next pop
+ */
+node_t *radix_heap_front(radix_heap_t *heap)
+{
+    radix_bucket_t *bucket;
+    size_t best;
+
+    if ((heap == NULL) || (heap->size == 0))
+        return NULL;
+
+    // Any item of bucket 0 has the smallest key
+    bucket = &heap->buckets[0];
+    if (bucket->size != 0)
+        return bucket->entries[bucket->size - 1].node;
+
+    if (heap->front == NULL)
+    {
+        bucket = &heap->buckets[first_bucket(heap)];
+        best = bucket_min(bucket);
+        heap->front = bucket->entries[best].node;
+        heap->front_key = bucket->entries[best].key;
+    }
+    return heap->front;
+}
+
+/**
+ * @brief Get a pointer to the item with the largest key in a heap
+ * @param heap Pointer to the heap structure
+ * @return A pointer to the node, NULL if the heap is empty
+ * @note Only the last non empty bucket is scanned, but this is still O(n)
+ */
+node_t *radix_heap_back(radix_heap_t *heap)
+{
+    radix_bucket_t *bucket;
+    size_t best;
+
+    if ((heap == NULL) || (heap->size == 0))
+        return NULL;
+
+    best = back_position(heap, &bucket);
+    return bucket->entries[best].node;
+}
+
+/**
+ * @brief Clear a heap's contents
+ * @param heap Pointer to the heap structure
+ * @note Any key can be pushed again afterwards
+ */
+void radix_heap_clear(radix_heap_t *heap)
+{
+    radix_bucket_t *bucket;
+    int i;
+
+#ifdef DEBUG
+    printf("Clearing radix heap...\n");
+#endif
+    for (i = 0; i < RADIX_HEAP_BUCKETS; i++)
+    {
+        bucket = &heap->buckets[i];
+        while (bucket->size > 0)
+        {
+            free(bucket->entries[--bucket->size].node);
+        }
+    }
+    heap->last = 0;
+    heap->size = 0;
+    heap->front = NULL;
+}
@@ -0,0 +1,45 @@
+#ifndef _RADIX_HEAP_H
+#define _RADIX_HEAP_H
+
+#include "sorted_list.h"
+#include <stdint.h>
+
+// One bucket for items whose key equals the last popped key, plus one per bit where keys may differ
+#define RADIX_HEAP_BUCKETS 65
+
+typedef struct radix_entry
+{
+    uint64_t key;
+    node_t *node;
+} radix_entry_t;
+
+typedef struct radix_bucket
+{
+    radix_entry_t *entries;
+    size_t size;
+    size_t capacity;
+} radix_bucket_t;
+
+typedef struct radix_heap
+{
+    radix_bucket_t buckets[RADIX_HEAP_BUCKETS];
+    uint64_t last;
+    size_t size;
+    size_t key_offset;
+    node_t *front;
+    uint64_t front_key;
+} radix_heap_t;
+
+radix_heap_t *radix_heap_new(size_t key_offset);
+void radix_heap_destroy(radix_heap_t *heap);
+int radix_heap_empty(radix_heap_t *heap);
+size_t radix_heap_size(radix_heap_t *heap);
+int radix_heap_push(radix_heap_t *heap, void *data, size_t data_size);
+void radix_heap_pop(radix_heap_t *heap, void *dest);
+void radix_heap_pop_back(radix_heap_t *heap, void *dest);
+int radix_heap_peek(radix_heap_t *heap, void *dest);
+node_t *radix_heap_front(radix_heap_t *heap);
+node_t *radix_heap_back(radix_heap_t *heap);
+void radix_heap_clear(radix_heap_t *heap);
+
+#endif
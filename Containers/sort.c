@@ -0,0 +1,490 @@
+#include "sort.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Enough pending runs for any list that fits in memory, bin k holds about 2^k runs
+#define SORT_MAX_BINS 64
+// Number of comparison functions radix_sort() can know the key of
+#define RADIX_SORT_MAX_KEYS 16
+#define RADIX_SORT_BUCKETS 256
+#define PARALLEL_SORT_MAX_THREADS 64
+// Shorter segments aren't worth a thread of their own
+#define PARALLEL_SORT_MIN_SEGMENT 16384
+
+typedef struct radix_key
+{
+    cmp_func_t compare;
+    size_t offset;
+    size_t width;
+    int is_signed;
+    int descending;
+} radix_key_t;
+
+// Key descriptors of the comparison functions radix_sort() can replace, filled at start-up
+static radix_key_t radix_keys[RADIX_SORT_MAX_KEYS];
+
+typedef struct radix_item
+{
+    uint64_t key;
+    node_t *node;
+} radix_item_t;
+
+typedef struct sort_task
+{
+    node_t *head;
+    node_t *other;
+    cmp_func_t compare;
+} sort_task_t;
+
+// Number of threads parallel_merge_sort() uses, 0 for one per online processor
+static int parallel_sort_threads;
+
+/**
+ * @brief Merge two sorted lists, keeping equal items in their original order
+ * @param front First of the merging lists, its items go first on ties
+ * @param back Second of the merging lists
+ * @param compare Comparison function
+ * @return A pointer to the head of the merged list
+ * @note Internal use only
+ */
+static node_t *sorted_merge(node_t *front, node_t *back, cmp_func_t compare)
+{
+    node_t *head = NULL;
+    node_t **link = &head;
+
+    // Append the smaller head to the result until either list runs out
+    while ((front != NULL) && (back != NULL))
+    {
+        if (compare(front->data, front->data_size, back->data, back->data_size) <= 0)
+        {
+            *link = front;
+            front = front->next;
+        }
+        else
+        {
+            *link = back;
+            back = back->next;
+        }
+        link = &(*link)->next;
+    }
+    *link = (front != NULL) ? front : back;
+
+    return head;
+}
+
+/**
+ * @brief Detach the sorted run at the start of a list
+ * @param head_ref Reference to the head of the list, updated to the rest of it
+ * @param compare Comparison function
+ * @return A pointer to the head of the run
+ * @note Strictly descending runs are reversed, ties never are so the sort stays stable.
+ *       Internal use only
+ */
+static node_t *take_run(node_t **head_ref, cmp_func_t compare)
+{
+    node_t *run = *head_ref;
+    node_t *last = run;
+    node_t *next;
+    node_t *reversed = NULL;
+
+    if ((last->next != NULL) &&
+        (compare(last->next->data, last->next->data_size, last->data, last->data_size) < 0))
+    {
+        // Reverse a strictly descending run as it is detached
+        do
+        {
+            next = last->next;
+            last->next = reversed;
+            reversed = last;
+            last = next;
+        } while ((last->next != NULL) &&
+                 (compare(last->next->data, last->next->data_size, last->data, last->data_size) < 0));
+
+        // The node that ended the descent is still part of it
+        *head_ref = last->next;
+        last->next = reversed;
+        return last;
+    }
+
+    // Extend a non-descending run as far as it goes
+    while ((last->next != NULL) &&
+           (compare(last->data, last->data_size, last->next->data, last->next->data_size) <= 0))
+    {
+        last = last->next;
+    }
+    *head_ref = last->next;
+    last->next = NULL;
+
+    return run;
+}
+
+/**
+ * @brief Sort a singly-linked list with an iterative, bottom-up natural merge sort
+ * @param head_ref Reference to the head of the list
+ * @param compare Comparison function used for merging lists
+ * @note Stable. Already sorted runs are merged as they are, so sorted or reversed input
+ *       costs O(n) and the worst case is O(n log n), without recursion or allocations.
+ */
+void natural_merge_sort(node_t **head_ref, cmp_func_t compare)
+{
+    node_t *bins[SORT_MAX_BINS] = { NULL };
+    node_t *rest, *run;
+    int i, top = 0;
+
+    // A list with less than two items is already sorted
+    if ((head_ref == NULL) || (*head_ref == NULL) || ((*head_ref)->next == NULL) || (compare == NULL))
+        return;
+
+    // Add runs to a binary counter of pending merges, earlier runs always stay in front
+    rest = *head_ref;
+    while (rest != NULL)
+    {
+        run = take_run(&rest, compare);
+        for (i = 0; (i < SORT_MAX_BINS - 1) && (bins[i] != NULL); i++)
+        {
+            run = sorted_merge(bins[i], run, compare);
+            bins[i] = NULL;
+        }
+        // The last bin absorbs anything beyond the counter's range
+        if (bins[i] != NULL)
+            run = sorted_merge(bins[i], run, compare);
+        bins[i] = run;
+        if (i >= top)
+            top = i + 1;
+    }
+
+    // Merge the remaining bins, from the most recent to the oldest
+    run = NULL;
+    for (i = 0; i < top; i++)
+    {
+        if (bins[i] != NULL)
+            run = sorted_merge(bins[i], run, compare);
+    }
+    *head_ref = run;
+}
+
+/**
+ * @brief Declare the integer key a comparison function orders items by
+ * @param compare Comparison function
+ * @param offset Position of the key within every item in bytes
+ * @param width Size of the key in bytes, 1, 2, 4 or 8
+ * @param is_signed Non-zero if the key is a signed integer
+ * @param descending Non-zero if compare puts greater keys first
+ * @return 0 on success, -1 on error
+ * @note The key is read in the host's byte order. Registration is not thread-safe and is
+ *       meant to happen at start-up, before any sort runs.
+ */
+int radix_sort_register(cmp_func_t compare, size_t offset, size_t width, int is_signed, int descending)
+{
+    int i, slot = -1;
+
+    if ((compare == NULL) || ((width != 1) && (width != 2) && (width != 4) && (width != 8)))
+        return -1;
+
+    // Update an existing declaration, or take the first free slot
+    for (i = 0; i < RADIX_SORT_MAX_KEYS; i++)
+    {
+        if (radix_keys[i].compare == compare)
+        {
+            slot = i;
+            break;
+        }
+        if ((slot < 0) && (radix_keys[i].compare == NULL))
+            slot = i;
+    }
+    if (slot < 0)
+        return -1;
+
+    radix_keys[slot] = (radix_key_t){ compare, offset, width, is_signed ? 1 : 0, descending ? 1 : 0 };
+    return 0;
+}
+
+/**
+ * @brief Forget the key declared for a comparison function
+ * @param compare Comparison function
+ */
+void radix_sort_unregister(cmp_func_t compare)
+{
+    int i;
+
+    for (i = 0; i < RADIX_SORT_MAX_KEYS; i++)
+    {
+        if ((compare != NULL) && (radix_keys[i].compare == compare))
+            radix_keys[i] = (radix_key_t){ 0 };
+    }
+}
+
+/**
+ * @brief Read an item's key as an unsigned integer that sorts in the desired order
+ * @param key Key descriptor
+ * @param data Item
+ * @return The transformed key
+ * @note Internal use only
+ */
+static uint64_t radix_key_of(radix_key_t *key, unsigned char *data)
+{
+    uint8_t u8;
+    uint16_t u16;
+    uint32_t u32;
+    uint64_t value;
+
+    // Copy the key out, as items don't guarantee its alignment
+    switch (key->width)
+    {
+    case 1:
+        memcpy(&u8, data + key->offset, 1);
+        value = u8;
+        break;
+    case 2:
+        memcpy(&u16, data + key->offset, 2);
+        value = u16;
+        break;
+    case 4:
+        memcpy(&u32, data + key->offset, 4);
+        value = u32;
+        break;
+    default:
+        memcpy(&value, data + key->offset, 8);
+        break;
+    }
+
+    // Flipping the sign bit orders two's complement keys as unsigned ones
+    if (key->is_signed)
+        value ^= (uint64_t)1 << (key->width * 8 - 1);
+    // Complementing the key reverses the order
+    if (key->descending)
+        value = ~value;
+    return value;
+}
+
+/**
+ * @brief Sort a singly-linked list with an LSD radix sort on a declared integer key
+ * @param head_ref Reference to the head of the list
+ * @param compare Comparison function, only used to look up the key declared for it
+ * @note Stable, O(n * width) with no comparison calls. Keys are gathered along with their
+ *       nodes into a temporary array so every pass scans memory sequentially, and digits
+ *       every key shares are skipped. Falls back to natural_merge_sort() if no key was
+ *       declared for compare, some item is too short to hold it or memory runs out.
+ */
+void radix_sort(node_t **head_ref, cmp_func_t compare)
+{
+    size_t counts[8][RADIX_SORT_BUCKETS] = { { 0 } };
+    radix_item_t *items, *buffer, *temp;
+    radix_key_t *key = NULL;
+    node_t *iterator;
+    size_t count = 0;
+    size_t offset, total, digit, i;
+    int pass;
+
+    // A list with less than two items is already sorted
+    if ((head_ref == NULL) || (*head_ref == NULL) || ((*head_ref)->next == NULL) || (compare == NULL))
+        return;
+
+    for (i = 0; i < RADIX_SORT_MAX_KEYS; i++)
+    {
+        if (radix_keys[i].compare == compare)
+            key = &radix_keys[i];
+    }
+
+    // Every item must hold the declared key
+    for (iterator = *head_ref; (key != NULL) && (iterator != NULL); iterator = iterator->next)
+    {
+        if (iterator->data_size < key->offset + key->width)
+            key = NULL;
+        count++;
+    }
+    items = (key != NULL) ? malloc(2 * count * sizeof *items) : NULL;
+    if (items == NULL)
+    {
+        natural_merge_sort(head_ref, compare);
+        return;
+    }
+    buffer = items + count;
+
+    // Gather the keys and histogram every digit in a single pass
+    for (iterator = *head_ref, i = 0; iterator != NULL; iterator = iterator->next, i++)
+    {
+        items[i].key = radix_key_of(key, iterator->data);
+        items[i].node = iterator;
+        for (pass = 0; pass < (int)key->width; pass++)
+            counts[pass][(items[i].key >> (pass * 8)) & 0xff]++;
+    }
+
+    // Distribute the items by each digit, least significant first, keeping their order on ties
+    for (pass = 0; pass < (int)key->width; pass++)
+    {
+        // All keys share this digit, so the pass wouldn't move anything
+        if (counts[pass][(items[0].key >> (pass * 8)) & 0xff] == count)
+            continue;
+
+        // Turn the histogram into the first position of every bucket
+        for (digit = 0, total = 0; digit < RADIX_SORT_BUCKETS; digit++)
+        {
+            offset = counts[pass][digit];
+            counts[pass][digit] = total;
+            total += offset;
+        }
+        for (i = 0; i < count; i++)
+            buffer[counts[pass][(items[i].key >> (pass * 8)) & 0xff]++] = items[i];
+        temp = items;
+        items = buffer;
+        buffer = temp;
+    }
+
+    // Relink the nodes in their sorted order
+    for (i = 0; i + 1 < count; i++)
+        items[i].node->next = items[i + 1].node;
+    items[count - 1].node->next = NULL;
+    *head_ref = items[0].node;
+
+    free((items < buffer) ? items : buffer);
+}
+
+/**
+ * @brief Set the number of threads parallel_merge_sort() uses
+ * @param threads Number of threads, 0 for one per online processor
+ * @note Not thread-safe, meant to be set at start-up
+ */
+void parallel_sort_set_threads(int threads)
+{
+    parallel_sort_threads = (threads > 0) ? threads : 0;
+}
+
+/**
+ * @brief Get the number of threads parallel_merge_sort() uses
+ * @return Number of threads
+ */
+int parallel_sort_get_threads(void)
+{
+    long online;
+
+    if (parallel_sort_threads > 0)
+        return (parallel_sort_threads < PARALLEL_SORT_MAX_THREADS) ? parallel_sort_threads : PARALLEL_SORT_MAX_THREADS;
+
+    online = sysconf(_SC_NPROCESSORS_ONLN);
+    if (online < 1)
+        return 1;
+    return (online < PARALLEL_SORT_MAX_THREADS) ? (int)online : PARALLEL_SORT_MAX_THREADS;
+}
+
+/**
+ * @brief Worker routine sorting one segment of a list
+ * @param arg Pointer to the task structure
+ * @return NULL
+ * @note Internal use only
+ */
+static void *sort_worker(void *arg)
+{
+    sort_task_t *task = arg;
+
+    natural_merge_sort(&task->head, task->compare);
+    return NULL;
+}
+
+/**
+ * @brief Worker routine merging two adjacent sorted segments of a list
+ * @param arg Pointer to the task structure, the other segment follows head in the list
+ * @return NULL
+ * @note Internal use only
+ */
+static void *merge_worker(void *arg)
+{
+    sort_task_t *task = arg;
+
+    task->head = sorted_merge(task->head, task->other, task->compare);
+    return NULL;
+}
+
+/**
+ * @brief Run a number of tasks concurrently, the calling thread taking the first one
+ * @param tasks Array of task structures
+ * @param count Number of tasks
+ * @param routine Worker routine
+ * @note Tasks whose thread can't be created run in the calling thread. Internal use only
+ */
+static void run_tasks(sort_task_t *tasks, int count, void *(*routine)(void *))
+{
+    pthread_t threads[PARALLEL_SORT_MAX_THREADS];
+    int started[PARALLEL_SORT_MAX_THREADS];
+    int i;
+
+    for (i = 1; i < count; i++)
+        started[i] = (pthread_create(&threads[i], NULL, routine, &tasks[i]) == 0);
+    routine(&tasks[0]);
+    for (i = 1; i < count; i++)
+    {
+        if (started[i])
+            pthread_join(threads[i], NULL);
+        else
+            routine(&tasks[i]);
+    }
+}
+
+/**
+ * @brief Sort a singly-linked list on several threads
+ * @param head_ref Reference to the head of the list
+ * @param compare Comparison function used for merging lists, called concurrently
+ * @note Stable. The list is cut into one segment per thread, the segments are sorted
+ *       concurrently with natural_merge_sort(), then adjacent pairs are merged concurrently
+ *       until one list is left. Short lists are sorted in the calling thread.
+ */
+void parallel_merge_sort(node_t **head_ref, cmp_func_t compare)
+{
+    sort_task_t tasks[PARALLEL_SORT_MAX_THREADS];
+    node_t *segments[PARALLEL_SORT_MAX_THREADS];
+    node_t *iterator;
+    size_t count = 0;
+    size_t length, i;
+    int threads, pairs, j;
+
+    // A list with less than two items is already sorted
+    if ((head_ref == NULL) || (*head_ref == NULL) || ((*head_ref)->next == NULL) || (compare == NULL))
+        return;
+
+    // Use as many threads as the list has segments worth sorting apart
+    for (iterator = *head_ref; iterator != NULL; iterator = iterator->next)
+        count++;
+    threads = parallel_sort_get_threads();
+    if ((size_t)threads > count / PARALLEL_SORT_MIN_SEGMENT)
+        threads = (int)(count / PARALLEL_SORT_MIN_SEGMENT);
+    if (threads < 2)
+    {
+        natural_merge_sort(head_ref, compare);
+        return;
+    }
+
+    // Cut the list into segments of nearly equal length, in order
+    iterator = *head_ref;
+    for (j = 0; j < threads; j++)
+    {
+        length = count / threads + (((size_t)j < count % threads) ? 1 : 0);
+        tasks[j] = (sort_task_t){ iterator, NULL, compare };
+        for (i = 1; i < length; i++)
+            iterator = iterator->next;
+        segments[j] = iterator->next;
+        iterator->next = NULL;
+        iterator = segments[j];
+    }
+    run_tasks(tasks, threads, sort_worker);
+
+    // Merge adjacent segments pairwise, earlier segments first on ties, until one is left
+    for (j = 0; j < threads; j++)
+        segments[j] = tasks[j].head;
+    while (threads > 1)
+    {
+        pairs = threads / 2;
+        for (j = 0; j < pairs; j++)
+            tasks[j] = (sort_task_t){ segments[2 * j], segments[2 * j + 1], compare };
+        run_tasks(tasks, pairs, merge_worker);
+        for (j = 0; j < pairs; j++)
+            segments[j] = tasks[j].head;
+        // An odd segment out moves on to the next round as it is
+        if (threads % 2)
+            segments[pairs] = segments[threads - 1];
+        threads = pairs + threads % 2;
+    }
+    *head_ref = segments[0];
+}
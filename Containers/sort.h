@@ -0,0 +1,14 @@
+#ifndef _SORT_H
+#define _SORT_H
+
+#include "sorted_list.h"
+
+void natural_merge_sort(node_t **head_ref, cmp_func_t compare);
+int radix_sort_register(cmp_func_t compare, size_t offset, size_t width, int is_signed, int descending);
+void radix_sort_unregister(cmp_func_t compare);
+void radix_sort(node_t **head_ref, cmp_func_t compare);
+void parallel_sort_set_threads(int threads);
+int parallel_sort_get_threads(void);
+void parallel_merge_sort(node_t **head_ref, cmp_func_t compare);
+
+#endif
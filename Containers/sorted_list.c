@@ -2,37 +2,46 @@
 #include <string.h>
 #ifdef DEBUG
 #include <stdio.h>
+#include <assert.h>
 #endif
 
+// Skip list nodes get one more level with probability 1/4, which keeps towers short
+#define SKIP_LIST_MAX_LEVEL 16
+#define SKIP_LIST_LEVEL_BITS 2
+
 /**
  * @brief Node constructor
  * @param data Data to be stored within the new node
  * @param type_size Size of the datatype stored within the new node in bytes
+ * @param height Number of skip list levels the node is linked into, 0 for a plain list node
  * @return An owning pointer that points to the new node
  * @note Internal use only
+ * @note Skip list nodes keep their height and their tower of forward links above level 0
+ *       at the start of the payload, ahead of the encapsulated data
  */
-static node_t *node_new(void *data, size_t type_size)
+static node_t *node_new(void *data, size_t type_size, int height)
 {
     node_t *new_node;
+    size_t tower_size = 0;
 
     // Empty list items aren't supported
     if ((data == NULL) || (type_size == 0))
         return NULL;
 
-    // Reserve memory for the new node
-    new_node = malloc(sizeof *new_node);
+    if (height > 0)
+        tower_size = NODE_PAYLOAD_ROUND_UP(sizeof(size_t) + (height - 1) * sizeof(node_t *));
+
+    // Reserve memory for the new node, its tower and its encapsulated data in a single block
+    new_node = malloc(sizeof *new_node + tower_size + type_size);
     if (new_node != NULL)
     {
-        // Also reserve memory for the encapsulated data
-        new_node->data = malloc(type_size);
-        if (new_node->data == NULL)
-        {
-            free(new_node);
-            return NULL;
-        }
-        // Initialize the structure
+        // Initialize the structure, data is stored inline right after the links
+        new_node->data = new_node->payload + tower_size;
         memcpy(new_node->data, data, type_size);
+        new_node->data_size = type_size;
         new_node->next = NULL;
+        if (height > 0)
+            *(size_t *)new_node->payload = height;
     }
 
     // Return a pointer to the new node structure
@@ -51,8 +60,7 @@ static void node_destroy(node_t *node)
 {
     if (node != NULL)
     {
-        // Free memory allocated to the node structure and its internal data
-        free(node->data);
+        // Data is stored inline, so a single block holds the whole node
         free(node);
 #ifdef DEBUG
     printf("Destroyed node at %lx\n", (unsigned long int)node);
@@ -60,6 +68,115 @@ static void node_destroy(node_t *node)
     }
 }
 
+/**
+ * @brief Get the number of skip list levels a node is linked into
+ * @param node Pointer to a skip list node
+ * @return Height of the node's tower
+ * @note Internal use only
+ */
+static int node_height(node_t *node)
+{
+    return (int)*(size_t *)node->payload;
+}
+
+/**
+ * @brief Get the forward link of a skip list node at a given level
+ * @param list Pointer to the list structure
+ * @param node Pointer to the node, NULL for the list's own head tower
+ * @param level Level of the link
+ * @return A reference to the link
+ * @note Internal use only
+ */
+static node_t **skip_link(sorted_list_t *list, node_t *node, int level)
+{
+    // Level 0 is the plain chain of next pointers every list operation walks
+    if (node == NULL)
+        return (level == 0) ? &list->head : &list->index[level];
+    if (level == 0)
+        return &node->next;
+    return (node_t **)(node->payload + sizeof(size_t)) + (level - 1);
+}
+
+/**
+ * @brief Pick a random height for a new skip list node
+ * @param list Pointer to the list structure
+ * @return Height between 1 and SKIP_LIST_MAX_LEVEL
+ * @note Internal use only
+ */
+static int skip_random_height(sorted_list_t *list)
+{
+    unsigned int bits;
+    int height = 1;
+
+    // Xorshift keeps the generator private to the list
+    bits = list->seed;
+    bits ^= bits << 13;
+    bits ^= bits >> 17;
+    bits ^= bits << 5;
+    list->seed = bits;
+
+    while (((bits & ((1u << SKIP_LIST_LEVEL_BITS) - 1)) == 0) && (height < SKIP_LIST_MAX_LEVEL))
+    {
+        bits >>= SKIP_LIST_LEVEL_BITS;
+        height++;
+    }
+
+    return height;
+}
+
+/**
+ * @brief Find the last node at every skip list level that sorts before a given item
+ * @param list Pointer to the list structure
+ * @param data Item to look for
+ * @param data_size Size of the item in bytes
+ * @param inclusive Also step over nodes that compare equal to the item
+ * @param update Destination for the predecessor at each level, NULL meaning the list's head
+ * @note Internal use only
+ */
+static void skip_search(sorted_list_t *list, void *data, size_t data_size, int inclusive, node_t **update)
+{
+    node_t *current = NULL;
+    node_t *next;
+    int level;
+    int cmp;
+
+    // Descend from the highest level, moving right while the next node sorts before the item
+    for (level = list->levels - 1; level >= 0; level--)
+    {
+        while ((next = *skip_link(list, current, level)) != NULL)
+        {
+            cmp = list->compare(next->data, next->data_size, data, data_size);
+            if ((cmp > 0) || ((cmp == 0) && !inclusive))
+                break;
+            current = next;
+        }
+        update[level] = current;
+    }
+}
+
+/**
+ * @brief Unlink a node from every skip list level it belongs to
+ * @param list Pointer to the list structure
+ * @param node Node to be unlinked
+ * @param update Predecessors of the node at each level
+ * @note Internal use only
+ */
+static void skip_unlink(sorted_list_t *list, node_t *node, node_t **update)
+{
+    int level;
+
+    for (level = 0; level < node_height(node); level++)
+    {
+        *skip_link(list, update[level], level) = *skip_link(list, node, level);
+    }
+
+    // Drop empty levels from the top of the head tower
+    while ((list->levels > 1) && (list->index[list->levels - 1] == NULL))
+    {
+        list->levels--;
+    }
+}
+
 /**
  * @brief Sorted list constructor
  * @param compare Comparison function used to decide if two items are sorted
@@ -76,8 +193,13 @@ sorted_list_t* sorted_list_new(cmp_func_t compare, sort_func_t sort)
     {
         // Initialize the structure
         new_list->head = NULL;
+        new_list->tail = NULL;
+        new_list->size = 0;
         new_list->compare = compare;
         new_list->sort = sort;
+        new_list->index = NULL;
+        new_list->levels = 0;
+        new_list->seed = 0;
     }
 
     // Return a pointer to the new list structure
@@ -87,6 +209,35 @@ sorted_list_t* sorted_list_new(cmp_func_t compare, sort_func_t sort)
     return new_list;
 }
 
+/**
+ * @brief Skip list backed sorted list constructor
+ * @param compare Comparison function used to decide if two items are sorted
+ * @param sort Sorting algorithm to be used on the list
+ * @return An owning pointer that points to the new list
+ * @note Insertion, search and erasure take expected O(log n) through a tower of forward links
+ *       kept in each node. The level 0 links are the regular next pointers.
+ */
+sorted_list_t *sorted_list_new_skip(cmp_func_t compare, sort_func_t sort)
+{
+    sorted_list_t *new_list;
+
+    new_list = sorted_list_new(compare, sort);
+    if (new_list != NULL)
+    {
+        // Also reserve the head tower, its level 0 is the list's head
+        new_list->index = calloc(SKIP_LIST_MAX_LEVEL, sizeof *new_list->index);
+        if (new_list->index == NULL)
+        {
+            free(new_list);
+            return NULL;
+        }
+        new_list->levels = 1;
+        new_list->seed = (0x9e3779b9u ^ (unsigned int)(size_t)new_list) | 1u;
+    }
+
+    return new_list;
+}
+
 /**
  * @brief Sorted list destructor
  * @param list Pointer to the list structure to be destroyed
@@ -100,6 +251,7 @@ void sorted_list_destroy(sorted_list_t *list)
     printf("Destroying list...\n");
 #endif
         sorted_list_clear(list);
+        free(list->index);
         free(list);
 #ifdef DEBUG
     printf("Destroyed list at %lx\n", (unsigned long int)list);
@@ -125,18 +277,62 @@ int sorted_list_empty(sorted_list_t *list)
  */
 size_t sorted_list_size(sorted_list_t *list)
 {
+#ifdef DEBUG
     size_t ret = 0;
     node_t *iterator;
 
-    // Traverse the list counting the nodes
+    // Validate the item counter against a full traversal
     iterator = list->head;
     while (iterator != NULL)
     {
         ret++;
         iterator = iterator->next;
     }
+    assert(ret == list->size);
+#endif
+    // Every mutating operation keeps the item counter up to date
+    return list->size;
+}
+
+/**
+ * @brief Insert an item into a skip list backed list
+ * @param list Pointer to the list structure
+ * @param data Data to be stored within the new item
+ * @param data_size Size of data in bytes
+ * @return 0 on success, -1 on error
+ * @note Internal use only
+ */
+static int skip_insert(sorted_list_t *list, void *data, size_t data_size)
+{
+    node_t *update[SKIP_LIST_MAX_LEVEL];
+    node_t *new_item;
+    int height;
+    int level;
+
+    // Create a new node with a random tower height
+    height = skip_random_height(list);
+    new_item = node_new(data, data_size, height);
+    if (new_item == NULL)
+        return -1;
+
+    // Find the new node's predecessors, after any item of equal priority
+    skip_search(list, data, data_size, 1, update);
+    while (list->levels < height)
+    {
+        update[list->levels++] = NULL;
+    }
+
+    // Link the new node at every level of its tower
+    for (level = 0; level < height; level++)
+    {
+        *skip_link(list, new_item, level) = *skip_link(list, update[level], level);
+        *skip_link(list, update[level], level) = new_item;
+    }
+    if (new_item->next == NULL)
+        list->tail = new_item;
+    list->size++;
 
-    return ret;
+    return 0;
 }
 
 /**
@@ -145,22 +341,121 @@ size_t sorted_list_size(sorted_list_t *list)
  * @param data Data to be stored within the new item
  * @param data_size Size of data in bytes
  * @return 0 on success, -1 on error
+ * @note The list is already sorted, so the new item is linked at its place in a single pass
+ * @note Items of equal priority keep their insertion order
  */
 int sorted_list_insert(sorted_list_t *list, void *data, size_t data_size)
 {
     node_t *new_item;
+    node_t **link;
+
+    if (list->index != NULL)
+        return skip_insert(list, data, data_size);
 
     // Create a new node to encapsulate the data
-    new_item = node_new(data, data_size);
+    new_item = node_new(data, data_size, 0);
     if (new_item == NULL)
         return -1;
 
-    // Insert the new node at the front of the list
-    new_item->next = list->head;
-    list->head = new_item;
+    // Advance past every item that doesn't sort after the new one
+    link = &list->head;
+    while ((*link != NULL) && (list->compare((*link)->data, (*link)->data_size, data, data_size) <= 0))
+    {
+        link = &(*link)->next;
+    }
 
-    // Sort the list using its comparison function and sorting algorithm
-    list->sort(&list->head, list->compare);
+    // Link the new node in front of the first item that sorts after it
+    new_item->next = *link;
+    *link = new_item;
+    if (new_item->next == NULL)
+        list->tail = new_item;
+    list->size++;
+
+    return 0;
+}
+
+/**
+ * @brief Insert a run of items into a list
+ * @param list Pointer to the list structure
+ * @param data Array of items to be stored within the list
+ * @param data_size Size of each item in bytes
+ * @param count Number of items in the array
+ * @return 0 on success, -1 on error
+ * @note Only the new run is sorted, then it is merged into the list in a single pass
+ * @note On error the list is left untouched, except for skip lists which insert items one by one
+ */
+int sorted_list_insert_n(sorted_list_t *list, void *data, size_t data_size, size_t count)
+{
+    node_t *run = NULL;
+    node_t **run_tail = &run;
+    node_t *merged = NULL;
+    node_t **merged_tail = &merged;
+    node_t *current;
+    size_t i;
+
+    if ((data == NULL) || (count == 0))
+        return -1;
+
+    // Without a sorting algorithm, or with a skip list index to maintain, fall back to one-by-one insertion
+    if ((list->sort == NULL) || (list->index != NULL))
+    {
+        for (i = 0; i < count; i++)
+        {
+            if (sorted_list_insert(list, (unsigned char *)data + i * data_size, data_size) != 0)
+                return -1;
+        }
+        return 0;
+    }
+
+    // Encapsulate every item in a node, chained in array order
+    for (i = 0; i < count; i++)
+    {
+        *run_tail = node_new((unsigned char *)data + i * data_size, data_size, 0);
+        if (*run_tail == NULL)
+        {
+            while (run != NULL)
+            {
+                current = run;
+                run = run->next;
+                node_destroy(current);
+            }
+            return -1;
+        }
+        run_tail = &(*run_tail)->next;
+    }
+
+    // Sort the new run only
+    list->sort(&run, list->compare);
+
+    // Merge both sorted chains, existing items go first among equals
+    current = list->head;
+    while ((current != NULL) && (run != NULL))
+    {
+        if (list->compare(current->data, current->data_size, run->data, run->data_size) <= 0)
+        {
+            *merged_tail = current;
+            current = current->next;
+        }
+        else
+        {
+            *merged_tail = run;
+            run = run->next;
+        }
+        merged_tail = &(*merged_tail)->next;
+    }
+    *merged_tail = (current != NULL) ? current : run;
+    list->head = merged;
+    list->size += count;
+
+    // If the run outlasted the list, its last node becomes the tail
+    if (run != NULL)
+    {
+        while (run->next != NULL)
+        {
+            run = run->next;
+        }
+        list->tail = run;
+    }
 
     return 0;
 }
@@ -172,6 +467,7 @@ int sorted_list_insert(sorted_list_t *list, void *data, size_t data_size)
  */
 void sorted_list_pop_front(sorted_list_t *list, void *dest)
 {
+    node_t *update[SKIP_LIST_MAX_LEVEL] = { NULL };
     node_t *popped_node;
 
     // The list must exist and have at least one item to pop
@@ -180,8 +476,20 @@ void sorted_list_pop_front(sorted_list_t *list, void *dest)
 
     // The next node on the list becomes the new head
     popped_node = list->head;
-    list->head = popped_node->next;
-    
+    if (list->index != NULL)
+    {
+        // The front node's predecessor is the head tower at every level
+        skip_unlink(list, popped_node, update);
+    }
+    else
+    {
+        list->head = popped_node->next;
+    }
+    if (list->head == NULL)
+        list->tail = NULL;
+
+    list->size--;
+
     // Data from the popped node is copied into destination if provided
     if (dest != NULL)
     {
@@ -208,6 +516,18 @@ int sorted_list_peek_front(sorted_list_t *list, void *dest)
     return -1;
 }
 
+/**
+ * @brief Get a pointer to the item at the front of a list
+ * @param list Pointer to the list structure
+ * @return A pointer to the item's data, NULL if the list is empty
+ * @note The pointer is valid until the item is removed. Fields the comparison function
+ *       depends on must not be modified through it.
+ */
+void *sorted_list_front_ptr(sorted_list_t *list)
+{
+    return ((list != NULL) && (list->head != NULL)) ? list->head->data : NULL;
+}
+
 /**
  * @brief Extract the item at the back of a list
  * @param list Pointer to the list structure
@@ -215,33 +535,50 @@ int sorted_list_peek_front(sorted_list_t *list, void *dest)
  */
 void sorted_list_pop_back(sorted_list_t *list, void *dest)
 {
-    node_t *iterator;
+    node_t *update[SKIP_LIST_MAX_LEVEL];
+    node_t *iterator = NULL;
+    node_t *next;
     node_t *popped_node;
+    int level;
 
     // The list must exist and have at least one item to pop
     if ((list == NULL) || (list->head == NULL))
         return;
 
-    // Find the last item on the list
-    iterator = list->head;
-    while (iterator->next != NULL)
+    popped_node = list->tail;
+    if (list->index != NULL)
     {
-        if (iterator->next->next == NULL)
+        // Find the tail's predecessor at every level, descending from the highest one
+        for (level = list->levels - 1; level >= 0; level--)
         {
-            // The second to last node shall no longer have a node after it
-            popped_node = iterator->next;
-            iterator->next = NULL;
-            break;
+            while (((next = *skip_link(list, iterator, level)) != NULL) && (next != popped_node))
+            {
+                iterator = next;
+            }
+            update[level] = iterator;
         }
-        iterator = iterator->next;
+        skip_unlink(list, popped_node, update);
+    }
+    else if (list->head != popped_node)
+    {
+        // Find the second to last node, which shall no longer have a node after it
+        iterator = list->head;
+        while (iterator->next != popped_node)
+        {
+            iterator = iterator->next;
+        }
+        iterator->next = NULL;
     }
-    
-    // If the list is now empty, head must be NULL
-    if (iterator == list->head)
+    else
     {
+        // If the list is now empty, head must be NULL
         list->head = NULL;
     }
 
+    // The second to last node on the list becomes the new tail
+    list->tail = iterator;
+    list->size--;
+
     // Data from the popped node is copied into destination if provided
     if (dest != NULL)
     {
@@ -259,35 +596,192 @@ void sorted_list_pop_back(sorted_list_t *list, void *dest)
  */
 int sorted_list_peek_back(sorted_list_t *list, void *dest)
 {
-    node_t *iterator;
-
-    if ((list != NULL) && (list->head != NULL) && (dest != NULL))
+    if ((list != NULL) && (list->tail != NULL) && (dest != NULL))
     {
-        // Find the last item on the list
-        iterator = list->head;
-        while (iterator->next != NULL)
-        {
-            iterator = iterator->next;
-        }
         // Copy peeked data into its destination
-        memcpy(dest, iterator->data, iterator->data_size);
+        memcpy(dest, list->tail->data, list->tail->data_size);
         return 0;
     }
     return -1;
 }
 
+/**
+ * @brief Get a pointer to the item at the back of a list
+ * @param list Pointer to the list structure
+ * @return A pointer to the item's data, NULL if the list is empty
+ * @note The pointer is valid until the item is removed. Fields the comparison function
+ *       depends on must not be modified through it.
+ */
+void *sorted_list_back_ptr(sorted_list_t *list)
+{
+    return ((list != NULL) && (list->tail != NULL)) ? list->tail->data : NULL;
+}
+
 /**
  * @brief Clear a list's contents
  * @param list Pointer to the list structure
  */
 void sorted_list_clear(sorted_list_t *list)
 {
+    node_t *popped_node;
+
 #ifdef DEBUG
     printf("Clearing list...\n");
 #endif
-    while (sorted_list_empty(list) == 0)
+    while (list->head != NULL)
+    {
+        // Destroy nodes in order, the skip list index is reset as a whole below
+        popped_node = list->head;
+        list->head = popped_node->next;
+        node_destroy(popped_node);
+    }
+    list->tail = NULL;
+    list->size = 0;
+    if (list->index != NULL)
+    {
+        memset(list->index, 0, SKIP_LIST_MAX_LEVEL * sizeof *list->index);
+        list->levels = 1;
+    }
+}
+
+/**
+ * @brief Find the first item that doesn't sort before a given one
+ * @param list Pointer to the list structure
+ * @param data Item to look for
+ * @param data_size Size of the item in bytes
+ * @return A pointer to the node, or NULL if every item sorts before the given one
+ */
+node_t *sorted_list_lower_bound(sorted_list_t *list, void *data, size_t data_size)
+{
+    node_t *update[SKIP_LIST_MAX_LEVEL];
+    node_t *iterator;
+
+    if ((list == NULL) || (data == NULL))
+        return NULL;
+
+    if (list->index != NULL)
+    {
+        // The node after the level 0 predecessor is the bound
+        skip_search(list, data, data_size, 0, update);
+        return *skip_link(list, update[0], 0);
+    }
+
+    iterator = list->head;
+    while ((iterator != NULL) && (list->compare(iterator->data, iterator->data_size, data, data_size) < 0))
+    {
+        iterator = iterator->next;
+    }
+
+    return iterator;
+}
+
+/**
+ * @brief Find the first item that compares equal to a given one
+ * @param list Pointer to the list structure
+ * @param data Item to look for
+ * @param data_size Size of the item in bytes
+ * @return A pointer to the node, or NULL if no item matches
+ */
+node_t *sorted_list_find(sorted_list_t *list, void *data, size_t data_size)
+{
+    node_t *bound;
+
+    bound = sorted_list_lower_bound(list, data, data_size);
+    if ((bound != NULL) && (list->compare(bound->data, bound->data_size, data, data_size) == 0))
+        return bound;
+
+    return NULL;
+}
+
+/**
+ * @brief Remove the first item that compares equal to a given one
+ * @param list Pointer to the list structure
+ * @param data Item to look for
+ * @param data_size Size of the item in bytes
+ * @return 0 on success, -1 if no item matches
+ */
+int sorted_list_erase(sorted_list_t *list, void *data, size_t data_size)
+{
+    node_t *update[SKIP_LIST_MAX_LEVEL];
+    node_t *erased_node;
+    node_t *previous = NULL;
+
+    if ((list == NULL) || (data == NULL))
+        return -1;
+
+    if (list->index != NULL)
+    {
+        skip_search(list, data, data_size, 0, update);
+        erased_node = *skip_link(list, update[0], 0);
+        if ((erased_node == NULL) || (list->compare(erased_node->data, erased_node->data_size, data, data_size) != 0))
+            return -1;
+        skip_unlink(list, erased_node, update);
+        if (erased_node == list->tail)
+            list->tail = update[0];
+    }
+    else
+    {
+        // Advance until the first item that doesn't sort before the given one
+        erased_node = list->head;
+        while ((erased_node != NULL) && (list->compare(erased_node->data, erased_node->data_size, data, data_size) < 0))
+        {
+            previous = erased_node;
+            erased_node = erased_node->next;
+        }
+        if ((erased_node == NULL) || (list->compare(erased_node->data, erased_node->data_size, data, data_size) != 0))
+            return -1;
+        if (previous == NULL)
+            list->head = erased_node->next;
+        else
+            previous->next = erased_node->next;
+        if (erased_node == list->tail)
+            list->tail = previous;
+    }
+    list->size--;
+    node_destroy(erased_node);
+
+    return 0;
+}
+
+/**
+ * @brief Re-sort a list using its comparison function and sorting algorithm
+ * @param list Pointer to the list structure
+ * @note Needed after the comparison function changes, the tail and any skip list index are rebuilt
+ */
+void sorted_list_sort(sorted_list_t *list)
+{
+    node_t *last[SKIP_LIST_MAX_LEVEL];
+    node_t *iterator;
+    int level;
+
+    if ((list == NULL) || (list->sort == NULL))
+        return;
+
+    list->sort(&list->head, list->compare);
+
+    // Relink the upper levels of every tower in the new order
+    for (level = 0; level < SKIP_LIST_MAX_LEVEL; level++)
     {
-        // Destroy nodes by popping them into oblivion
-        sorted_list_pop_front(list, NULL);
+        last[level] = NULL;
+    }
+    list->tail = NULL;
+    for (iterator = list->head; iterator != NULL; iterator = iterator->next)
+    {
+        if (list->index != NULL)
+        {
+            for (level = 1; level < node_height(iterator); level++)
+            {
+                *skip_link(list, last[level], level) = iterator;
+                last[level] = iterator;
+            }
+        }
+        list->tail = iterator;
+    }
+    if (list->index != NULL)
+    {
+        for (level = 1; level < list->levels; level++)
+        {
+            *skip_link(list, last[level], level) = NULL;
+        }
     }
 }
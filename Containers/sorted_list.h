@@ -2,6 +2,7 @@
 #define _SORTED_LIST_H
 
 #include <stdlib.h>
+#include <stddef.h>
 
 typedef struct node node_t;
 
@@ -10,27 +11,45 @@ struct node
     void *data;
     size_t data_size;
     node_t *next;
+    // Inline data starts at an address suitable for any type, like a malloc block
+    _Alignas(max_align_t) unsigned char payload[];
 };
 
+// Offsets of data stored past other fields in a node's payload are rounded up to this boundary
+#define NODE_PAYLOAD_ROUND_UP(x) (((x) + _Alignof(max_align_t) - 1) & ~((size_t)_Alignof(max_align_t) - 1))
+
 typedef int (*cmp_func_t) (void *data1, int data1_size, void *data2, int data2_size);
 typedef void (*sort_func_t) (node_t **head_ref, cmp_func_t compare);
 
 typedef struct sorted_list
 {
     node_t *head;
+    node_t *tail;
+    size_t size;
     cmp_func_t compare;
     sort_func_t sort;
+    node_t **index;
+    int levels;
+    unsigned int seed;
 } sorted_list_t;
 
 sorted_list_t *sorted_list_new(cmp_func_t compare, sort_func_t sort);
+sorted_list_t *sorted_list_new_skip(cmp_func_t compare, sort_func_t sort);
 void sorted_list_destroy(sorted_list_t *list);
 int sorted_list_empty(sorted_list_t *list);
 size_t sorted_list_size(sorted_list_t *list);
 int sorted_list_insert(sorted_list_t *list, void *data, size_t data_size);
+int sorted_list_insert_n(sorted_list_t *list, void *data, size_t data_size, size_t count);
 void sorted_list_pop_front(sorted_list_t *list, void *dest);
 int sorted_list_peek_front(sorted_list_t *list, void *dest);
+void *sorted_list_front_ptr(sorted_list_t *list);
 void sorted_list_pop_back(sorted_list_t *list, void *dest);
 int sorted_list_peek_back(sorted_list_t *list, void *dest);
+void *sorted_list_back_ptr(sorted_list_t *list);
 void sorted_list_clear(sorted_list_t *list);
+node_t *sorted_list_find(sorted_list_t *list, void *data, size_t data_size);
+node_t *sorted_list_lower_bound(sorted_list_t *list, void *data, size_t data_size);
+int sorted_list_erase(sorted_list_t *list, void *data, size_t data_size);
+void sorted_list_sort(sorted_list_t *list);
 
 #endif
\ No newline at end of file
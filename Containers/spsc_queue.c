@@ -0,0 +1,186 @@
+#include "spsc_queue.h"
+#include <string.h>
+
+#ifdef DEBUG
+#include <stdio.h>
+#endif
+
+#define SPSC_QUEUE_MIN_CAPACITY 2
+
+/**
+ * @brief Single-producer/single-consumer queue constructor
+ * @param elem_size Size of every item the queue stores in bytes
+ * @param capacity Minimum number of items the queue must hold, rounded up to a power of two
+ * @return An owning pointer that points to the new queue structure on success, NULL on error
+ * @note The queue never grows. Exactly one thread may push and exactly one thread may pop,
+ *       which lets both sides proceed without locks or read-modify-write instructions.
+ */
+spsc_queue_t *spsc_queue_new(size_t elem_size, size_t capacity)
+{
+    spsc_queue_t *new_queue;
+    size_t slots = SPSC_QUEUE_MIN_CAPACITY;
+
+    // Empty items aren't supported
+    if (elem_size == 0)
+        return NULL;
+    while (slots < capacity)
+        slots <<= 1;
+
+    // Reserve memory for the new queue structure, aligned so padded indices own their cache lines
+    new_queue = aligned_alloc(SPSC_QUEUE_CACHE_LINE, sizeof *new_queue);
+    if (new_queue != NULL)
+    {
+        // Also reserve memory for the ring buffer
+        new_queue->buffer = malloc(slots * elem_size);
+        if (new_queue->buffer == NULL)
+        {
+            free(new_queue);
+            return NULL;
+        }
+        atomic_init(&new_queue->head, 0);
+        atomic_init(&new_queue->tail, 0);
+        new_queue->cached_head = 0;
+        new_queue->cached_tail = 0;
+        new_queue->elem_size = elem_size;
+        new_queue->mask = slots - 1;
+    }
+
+    // Return a pointer to the new queue structure
+#ifdef DEBUG
+    printf("Created SPSC queue at %lx\n", (long unsigned int)new_queue);
+#endif
+    return new_queue;
+}
+
+/**
+ * @brief Single-producer/single-consumer queue destructor
+ * @param queue Pointer to the queue structure to be destroyed
+ * @note Neither side may be using the queue anymore
+ */
+void spsc_queue_destroy(spsc_queue_t *queue)
+{
+    if (queue != NULL)
+    {
+        free(queue->buffer);
+        free(queue);
+#ifdef DEBUG
+        printf("Destroyed SPSC queue at %lx\n", (long unsigned int)queue);
+#endif
+    }
+}
+
+/**
+ * @brief Check if a queue contains no items
+ * @param queue Pointer to the queue structure
+ * @return 1 for empty, 0 otherwise
+ * @note Exact when called by the consumer, a snapshot otherwise
+ */
+int spsc_queue_empty(spsc_queue_t *queue)
+{
+    return (spsc_queue_size(queue) == 0) ? 1 : 0;
+}
+
+/**
+ * @brief Check the number of items a queue contains
+ * @param queue Pointer to the queue structure
+ * @return Number of items contained in the queue
+ * @note Only a snapshot when the other side is running concurrently
+ */
+size_t spsc_queue_size(spsc_queue_t *queue)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+    return tail - head;
+}
+
+/**
+ * @brief Check the number of items a queue can hold
+ * @param queue Pointer to the queue structure
+ * @return Capacity of the queue
+ */
+size_t spsc_queue_capacity(spsc_queue_t *queue)
+{
+    return queue->mask + 1;
+}
+
+/**
+ * @brief Append an item to a queue
+ * @param queue Pointer to the queue structure
+ * @param data Data to be copied into the queue, elem_size bytes long
+ * @return 0 on success, -1 if the queue is full
+ * @note Producer side only, wait-free
+ */
+int spsc_queue_push(spsc_queue_t *queue, void *data)
+{
+    // Only the producer writes the tail, so a relaxed load returns its own last store
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+    // Only refresh the consumer index when the cached one says the queue is full
+    if (tail - queue->cached_head > queue->mask)
+    {
+        queue->cached_head = atomic_load_explicit(&queue->head, memory_order_acquire);
+        if (tail - queue->cached_head > queue->mask)
+            return -1;
+    }
+
+    // Fill the slot, then publish it; the release store orders the copy before the new tail
+    memcpy(queue->buffer + (tail & queue->mask) * queue->elem_size, data, queue->elem_size);
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+
+    return 0;
+}
+
+/**
+ * @brief Extract the oldest item from a queue
+ * @param queue Pointer to the queue structure
+ * @param dest Destination, elem_size bytes long, or NULL to discard the item
+ * @return 0 on success, -1 if the queue is empty
+ * @note Consumer side only, wait-free
+ */
+int spsc_queue_pop(spsc_queue_t *queue, void *dest)
+{
+    return (spsc_queue_pop_n(queue, dest, 1) == 1) ? 0 : -1;
+}
+
+/**
+ * @brief Extract up to count of the oldest items from a queue at once
+ * @param queue Pointer to the queue structure
+ * @param dest Destination array with room for count items, or NULL to discard them
+ * @param count Maximum number of items to extract
+ * @return Number of items extracted
+ * @note Consumer side only, wait-free. The whole batch is released with a single store.
+ */
+size_t spsc_queue_pop_n(spsc_queue_t *queue, void *dest, size_t count)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    size_t available = queue->cached_tail - head;
+    size_t offset, first;
+
+    // Only refresh the producer index when the cached one can't satisfy the request
+    if (available < count)
+    {
+        queue->cached_tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        available = queue->cached_tail - head;
+    }
+    if (count > available)
+        count = available;
+    if (count == 0)
+        return 0;
+
+    // Copy the batch out in at most two chunks, as it may wrap around the end of the ring
+    if (dest != NULL)
+    {
+        offset = head & queue->mask;
+        first = queue->mask + 1 - offset;
+        if (first > count)
+            first = count;
+        memcpy(dest, queue->buffer + offset * queue->elem_size, first * queue->elem_size);
+        memcpy((unsigned char *)dest + first * queue->elem_size, queue->buffer, (count - first) * queue->elem_size);
+    }
+
+    // Hand the slots back to the producer once the copies are complete
+    atomic_store_explicit(&queue->head, head + count, memory_order_release);
+
+    return count;
+}
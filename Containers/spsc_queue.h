@@ -0,0 +1,33 @@
+#ifndef _SPSC_QUEUE_H
+#define _SPSC_QUEUE_H
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+// Indices written by different threads live on different cache lines to avoid false sharing
+#define SPSC_QUEUE_CACHE_LINE 64
+
+typedef struct spsc_queue
+{
+    // Consumer side: next slot to read, and the last producer index it observed
+    _Alignas(SPSC_QUEUE_CACHE_LINE) atomic_size_t head;
+    size_t cached_tail;
+    // Producer side: next slot to write, and the last consumer index it observed
+    _Alignas(SPSC_QUEUE_CACHE_LINE) atomic_size_t tail;
+    size_t cached_head;
+    // Read-only after construction
+    _Alignas(SPSC_QUEUE_CACHE_LINE) unsigned char *buffer;
+    size_t elem_size;
+    size_t mask;
+} spsc_queue_t;
+
+spsc_queue_t *spsc_queue_new(size_t elem_size, size_t capacity);
+void spsc_queue_destroy(spsc_queue_t *queue);
+int spsc_queue_empty(spsc_queue_t *queue);
+size_t spsc_queue_size(spsc_queue_t *queue);
+size_t spsc_queue_capacity(spsc_queue_t *queue);
+int spsc_queue_push(spsc_queue_t *queue, void *data);
+int spsc_queue_pop(spsc_queue_t *queue, void *dest);
+size_t spsc_queue_pop_n(spsc_queue_t *queue, void *dest, size_t count);
+
+#endif
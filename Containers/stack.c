@@ -1,8 +1,11 @@
 #include "stack.h"
+#include <string.h>
 #ifdef DEBUG
 #include <stdio.h>
 #endif
 
+#define STACK_MIN_CAPACITY 16
+
 /**
  * @brief Stack constructor
  * @return An owning pointer that points to the new stack structure on success, NULL on error 
@@ -16,6 +19,7 @@ stack_t *stack_new()
     if (new_stack != NULL)
     {
         // Also reserved memory for its internal representation
+        *new_stack = (stack_t){ 0 };
         new_stack->mem = list_new();
         if (new_stack->mem == NULL)
         {
@@ -31,6 +35,128 @@ stack_t *stack_new()
     return new_stack;
 }
 
+/**
+ * @brief Pooled stack constructor
+ * @param data_size Size of the datatype the stack is expected to store in bytes
+ * @param nodes_per_slab Number of nodes reserved at once when the pool runs dry, 0 for a default
+ * @return An owning pointer that points to the new stack structure on success, NULL on error
+ * @note Nodes are recycled through a pool owned by the stack's internal representation
+ */
+stack_t *stack_new_pooled(size_t data_size, size_t nodes_per_slab)
+{
+    stack_t *new_stack;
+    
+    // Reserve memory for the new stack structure
+    new_stack = malloc(sizeof *new_stack);
+    if (new_stack != NULL)
+    {
+        // Also reserved memory for its internal representation, backed by a node pool
+        *new_stack = (stack_t){ 0 };
+        new_stack->mem = list_new_pooled(data_size, nodes_per_slab);
+        if (new_stack->mem == NULL)
+        {
+            free(new_stack);
+            new_stack = NULL;
+        }
+    }
+
+    // Return a pointer to the new stack structure
+#ifdef DEBUG
+    printf("Created pooled stack at %lx\n", (long unsigned int)new_stack);
+#endif
+    return new_stack;
+}
+
+/**
+ * @brief Constructor for a stack sharing another stack's node pool
+ * @param other Pointer to the list-backed stack structure whose pool is shared
+ * @return An owning pointer that points to the new stack structure on success, NULL on error
+ * @note Stacks sharing a pool transfer their items in O(1), see stack_transfer()
+ */
+stack_t *stack_new_shared(stack_t *other)
+{
+    stack_t *new_stack;
+
+    // Fixed-size stacks have no nodes to share
+    if ((other == NULL) || (other->mem == NULL))
+        return NULL;
+
+    // Reserve memory for the new stack structure
+    new_stack = malloc(sizeof *new_stack);
+    if (new_stack != NULL)
+    {
+        // Also reserved memory for its internal representation, backed by the other stack's pool
+        *new_stack = (stack_t){ 0 };
+        new_stack->mem = list_new_shared(other->mem);
+        if (new_stack->mem == NULL)
+        {
+            free(new_stack);
+            new_stack = NULL;
+        }
+    }
+
+    // Return a pointer to the new stack structure
+#ifdef DEBUG
+    printf("Created stack at %lx sharing the pool of stack at %lx\n", (long unsigned int)new_stack, (long unsigned int)other);
+#endif
+    return new_stack;
+}
+
+/**
+ * @brief Fixed-size item stack constructor
+ * @param elem_size Size of every item the stack stores in bytes
+ * @param capacity_hint Number of items to reserve room for up front, 0 for a default
+ * @return An owning pointer that points to the new stack structure on success, NULL on error
+ * @note Items are stored contiguously in a buffer that doubles when full.
+ *       stack_top() and stack_bottom() return NULL on such stacks, use stack_top_ptr() and stack_bottom_ptr().
+ */
+stack_t *stack_new_fixed(size_t elem_size, size_t capacity_hint)
+{
+    stack_t *new_stack;
+
+    if (elem_size == 0)
+        return NULL;
+
+    // Reserve memory for the new stack structure
+    new_stack = malloc(sizeof *new_stack);
+    if (new_stack != NULL)
+    {
+        // Also reserved memory for its buffer
+        *new_stack = (stack_t){ 0 };
+        new_stack->elem_size = elem_size;
+        if (stack_reserve(new_stack, (capacity_hint > STACK_MIN_CAPACITY) ? capacity_hint : STACK_MIN_CAPACITY) != 0)
+        {
+            free(new_stack);
+            new_stack = NULL;
+        }
+    }
+
+    // Return a pointer to the new stack structure
+#ifdef DEBUG
+    printf("Created fixed-size stack at %lx\n", (long unsigned int)new_stack);
+#endif
+    return new_stack;
+}
+
+/**
+ * @brief Resize a stack's buffer
+ * @param stack Pointer to the stack structure
+ * @param capacity New capacity in items, must fit the current items
+ * @return 0 on success, -1 on error
+ * @note Internal use only
+ */
+static int stack_resize(stack_t *stack, size_t capacity)
+{
+    unsigned char *buffer;
+
+    buffer = realloc(stack->buffer, capacity * stack->elem_size);
+    if (buffer == NULL)
+        return -1;
+    stack->buffer = buffer;
+    stack->capacity = capacity;
+    return 0;
+}
+
 /**
  * @brief Stack destructor
  * @param stack Pointer to the stack structure
@@ -45,6 +171,7 @@ void stack_destroy(stack_t *stack)
 #endif
         if (stack->mem != NULL)
             list_destroy(stack->mem);
+        free(stack->buffer);
         free(stack);
 #ifdef DEBUG
         printf("Destroyed stack at %lx\n", (long unsigned int)stack);
@@ -59,6 +186,8 @@ void stack_destroy(stack_t *stack)
  */
 int stack_empty(stack_t *stack)
 {
+    if (stack->mem == NULL)
+        return (stack->count == 0) ? 1 : 0;
     return list_empty(stack->mem);
 }
 
@@ -69,6 +198,8 @@ int stack_empty(stack_t *stack)
  */
 size_t stack_size(stack_t *stack)
 {
+    if (stack->mem == NULL)
+        return stack->count;
     return list_size(stack->mem);
 }
 
@@ -78,11 +209,68 @@ size_t stack_size(stack_t *stack)
  * @param data New data item
  * @param data_size Size of data in bytes
  * @return 0 on success, -1 on error
+ * @note Fixed-size stacks only accept items of their own size
  */
 int stack_push(stack_t *stack, void *data, size_t data_size)
 {
+    void *dest;
+
+    if (data == NULL)
+        return -1;
+
+    // Reserve the new item in place, then fill it
+    dest = stack_emplace(stack, data_size);
+    if (dest == NULL)
+        return -1;
+    memcpy(dest, data, data_size);
+
+    return 0;
+}
+
+/**
+ * @brief Push an uninitialized data item onto a stack
+ * @param stack Pointer to the stack structure
+ * @param data_size Size of the new item in bytes
+ * @return A pointer to the new item for the caller to fill, NULL on error
+ * @note Fixed-size stacks only accept items of their own size
+ */
+void *stack_emplace(stack_t *stack, size_t data_size)
+{
+    if (stack->mem == NULL)
+    {
+        if (data_size != stack->elem_size)
+            return NULL;
+
+        // Grow geometrically so pushes stay amortized O(1)
+        if ((stack->count == stack->capacity) && (stack_resize(stack, 2 * stack->capacity) != 0))
+            return NULL;
+        return stack->buffer + stack->count++ * stack->elem_size;
+    }
+
     // Default stack behavior is pushing to the back
-    return list_push_back(stack->mem, data, data_size);
+    return list_emplace_back(stack->mem, data_size);
+}
+
+/**
+ * @brief Push a heap buffer onto a stack without copying it
+ * @param stack Pointer to the stack structure
+ * @param data Buffer obtained from malloc, owned by the stack on success
+ * @param data_size Size of the buffer in bytes
+ * @return 0 on success, -1 on error, in which case the caller keeps ownership of data
+ * @note Fixed-size stacks store items inline, so they copy the item and free the buffer
+ */
+int stack_push_owned(stack_t *stack, void *data, size_t data_size)
+{
+    if (stack->mem == NULL)
+    {
+        if (stack_push(stack, data, data_size) != 0)
+            return -1;
+        free(data);
+        return 0;
+    }
+
+    // Default stack behavior is pushing to the back
+    return list_push_back_owned(stack->mem, data, data_size);
 }
 
 /**
@@ -92,10 +280,60 @@ int stack_push(stack_t *stack, void *data, size_t data_size)
  */
 void stack_pop(stack_t *stack, void *dest)
 {
+    size_t floor;
+
+    if (stack->mem == NULL)
+    {
+        if (stack->count == 0)
+            return;
+
+        // Data from the top item is copied into destination if provided
+        stack->count--;
+        if (dest != NULL)
+            memcpy(dest, stack->buffer + stack->count * stack->elem_size, stack->elem_size);
+
+        // Halve the buffer once it is three quarters empty, leaving room to grow back without resizing,
+        // but never below the reserved capacity
+        floor = (stack->reserved > STACK_MIN_CAPACITY) ? stack->reserved : STACK_MIN_CAPACITY;
+        if (stack->shrink && (stack->capacity > floor) && (stack->count <= stack->capacity / 4))
+            stack_resize(stack, (stack->capacity / 2 > floor) ? stack->capacity / 2 : floor);
+        return;
+    }
+
     // Default stack behavior is popping from the back
     return list_pop_back(stack->mem, dest);
 }
 
+/**
+ * @brief Pop a data item from a stack as a heap buffer
+ * @param stack Pointer to the stack structure
+ * @param data_size Destination for the size of the item in bytes, may be NULL
+ * @return A buffer holding the item that the caller must free, NULL if the stack is empty or on error
+ * @note Buffers adopted by stack_push_owned() are returned without copying
+ */
+void *stack_pop_owned(stack_t *stack, size_t *data_size)
+{
+    void *data;
+
+    if (stack->mem == NULL)
+    {
+        if (stack->count == 0)
+            return NULL;
+
+        // Inline items have to move into a buffer of their own
+        data = malloc(stack->elem_size);
+        if (data == NULL)
+            return NULL;
+        stack_pop(stack, data);
+        if (data_size != NULL)
+            *data_size = stack->elem_size;
+        return data;
+    }
+
+    // Default stack behavior is popping from the back
+    return list_pop_back_owned(stack->mem, data_size);
+}
+
 /**
  * @brief Peek the last item pushed onto a stack
  * @param stack Pointer to the stack structure
@@ -104,6 +342,16 @@ void stack_pop(stack_t *stack, void *dest)
  */
 int stack_peek(stack_t *stack, void *dest)
 {
+    if (stack->mem == NULL)
+    {
+        if ((stack->count == 0) || (dest == NULL))
+            return -1;
+
+        // Copy peeked data into its destination
+        memcpy(dest, stack_top_ptr(stack), stack->elem_size);
+        return 0;
+    }
+
     // Last item pushed is at the back
     return list_peek_back(stack->mem, dest);
 }
@@ -111,23 +359,82 @@ int stack_peek(stack_t *stack, void *dest)
 /**
  * @brief Get a pointer to the top element in a stack
  * @param stack Pointer to the stack structure
- * @return A pointer to the top element in the stack structure
+ * @return A pointer to the top element in the stack structure, NULL for fixed-size stacks
  */
 node_t *stack_top(stack_t *stack)
 {
+    if (stack->mem == NULL)
+        return NULL;
     return stack->mem->tail;
 }
 
 /**
  * @brief Get a pointer to the bottom element in a stack
  * @param stack Pointer to the stack structure
- * @return A pointer to the bottom element in the stack structure
+ * @return A pointer to the bottom element in the stack structure, NULL for fixed-size stacks
  */
 node_t *stack_bottom(stack_t *stack)
 {
+    if (stack->mem == NULL)
+        return NULL;
     return stack->mem->head;
 }
 
+/**
+ * @brief Get a pointer to the data of the top element in a stack
+ * @param stack Pointer to the stack structure
+ * @return A pointer to the data, NULL if the stack is empty
+ * @note The pointer is only valid until the stack is modified
+ */
+void *stack_top_ptr(stack_t *stack)
+{
+    if (stack->mem != NULL)
+        return (stack->mem->tail != NULL) ? stack->mem->tail->data : NULL;
+    return (stack->count != 0) ? stack->buffer + (stack->count - 1) * stack->elem_size : NULL;
+}
+
+/**
+ * @brief Get a pointer to the data of the bottom element in a stack
+ * @param stack Pointer to the stack structure
+ * @return A pointer to the data, NULL if the stack is empty
+ * @note The pointer is only valid until the stack is modified
+ */
+void *stack_bottom_ptr(stack_t *stack)
+{
+    if (stack->mem != NULL)
+        return (stack->mem->head != NULL) ? stack->mem->head->data : NULL;
+    return (stack->count != 0) ? stack->buffer : NULL;
+}
+
+/**
+ * @brief Reserve room for a number of items in a fixed-size stack
+ * @param stack Pointer to the stack structure
+ * @param capacity Number of items the stack must hold without growing
+ * @return 0 on success, -1 on error or if the stack isn't a fixed-size one
+ * @note Shrinking on pop never takes the buffer below the largest capacity reserved
+ */
+int stack_reserve(stack_t *stack, size_t capacity)
+{
+    if (stack->mem != NULL)
+        return -1;
+    if ((capacity > stack->capacity) && (stack_resize(stack, capacity) != 0))
+        return -1;
+    if (capacity > stack->reserved)
+        stack->reserved = capacity;
+    return 0;
+}
+
+/**
+ * @brief Let a fixed-size stack give memory back as it empties
+ * @param stack Pointer to the stack structure
+ * @param enable Non-zero to halve the buffer whenever it is no more than a quarter full
+ * @note The buffer keeps at least the capacity reserved through stack_reserve() or stack_new_fixed()
+ */
+void stack_set_shrink_on_pop(stack_t *stack, int enable)
+{
+    stack->shrink = enable;
+}
+
 /**
  * @brief Clear a stack's contents
  * @param stack Pointer to the stack structure
@@ -137,6 +444,11 @@ void stack_clear(stack_t *stack)
 #ifdef DEBUG
     printf("Clearing stack...\n");
 #endif
+    if (stack->mem == NULL)
+    {
+        stack->count = 0;
+        return;
+    }
     list_clear(stack->mem);
 }
 
@@ -148,11 +460,70 @@ void stack_clear(stack_t *stack)
  */
 void stack_swap(stack_t *stacka, stack_t *stackb)
 {
-    list_t *temp;
-    temp = stacka->mem;
-    stacka->mem = stackb->mem;
-    stackb->mem = temp;
+    stack_t temp;
+    temp = *stacka;
+    *stacka = *stackb;
+    *stackb = temp;
 #ifdef DEBUG
     printf("Swapped contents of stack at %lx and stack at %lx\n", (long unsigned int)stacka, (long unsigned int)stackb);
 #endif
 }
+
+/**
+ * @brief Move every item of a stack on top of another one, keeping their order
+ * @param dest Pointer to the destination stack structure
+ * @param src Pointer to the source stack structure, left empty
+ * @return 0 on success, -1 on error
+ * @note List-backed stacks relink their nodes in O(1), and must share the same node pool,
+ *       see stack_new_shared(), or have none. Fixed-size stacks must store items of the same size,
+ *       and copy them unless the destination is empty. A list-backed and a fixed-size stack can't be mixed.
+ */
+int stack_transfer(stack_t *dest, stack_t *src)
+{
+    unsigned char *buffer;
+    size_t capacity;
+
+    if ((dest == NULL) || (src == NULL) || (dest == src))
+        return -1;
+    if ((dest->mem != NULL) && (src->mem != NULL))
+        return list_concat(dest->mem, src->mem);
+    if ((dest->mem != NULL) || (src->mem != NULL) || (dest->elem_size != src->elem_size))
+        return -1;
+
+    // An empty destination simply trades buffers with the source
+    if (dest->count == 0)
+    {
+        buffer = dest->buffer;
+        capacity = dest->capacity;
+        dest->buffer = src->buffer;
+        dest->capacity = src->capacity;
+        dest->count = src->count;
+        src->buffer = buffer;
+        src->capacity = capacity;
+        src->count = 0;
+        return 0;
+    }
+
+    // Otherwise make room for every item at once and copy them in a single block
+    capacity = dest->capacity;
+    while (capacity - dest->count < src->count)
+        capacity *= 2;
+    if ((capacity != dest->capacity) && (stack_resize(dest, capacity) != 0))
+        return -1;
+    memcpy(dest->buffer + dest->count * dest->elem_size, src->buffer, src->count * src->elem_size);
+    dest->count += src->count;
+    src->count = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Get the allocation counters of a pooled stack
+ * @param stack Pointer to the stack structure
+ * @param dest Destination
+ * @return 0 on success, -1 if the stack has no pool
+ */
+int stack_pool_stats(stack_t *stack, node_pool_stats_t *dest)
+{
+    return list_pool_stats(stack->mem, dest);
+}
@@ -6,18 +6,36 @@
 typedef struct stack
 {
     list_t * mem;
+    unsigned char *buffer;
+    size_t elem_size;
+    size_t capacity;
+    size_t reserved;
+    size_t count;
+    int shrink;
 } stack_t;
 
 stack_t *stack_new();
+stack_t *stack_new_pooled(size_t data_size, size_t nodes_per_slab);
+stack_t *stack_new_shared(stack_t *other);
+stack_t *stack_new_fixed(size_t elem_size, size_t capacity_hint);
 void stack_destroy(stack_t *stack);
 int stack_empty(stack_t *stack);
 size_t stack_size(stack_t *stack);
 int stack_push(stack_t *stack, void *data, size_t data_size);
+void *stack_emplace(stack_t *stack, size_t data_size);
+int stack_push_owned(stack_t *stack, void *data, size_t data_size);
 void stack_pop(stack_t *stack, void *dest);
+void *stack_pop_owned(stack_t *stack, size_t *data_size);
 int stack_peek(stack_t *stack, void *dest);
 node_t *stack_top(stack_t *stack);
 node_t *stack_bottom(stack_t *stack);
+void *stack_top_ptr(stack_t *stack);
+void *stack_bottom_ptr(stack_t *stack);
+int stack_reserve(stack_t *stack, size_t capacity);
+void stack_set_shrink_on_pop(stack_t *stack, int enable);
 void stack_clear(stack_t *stack);
 void stack_swap(stack_t *stacka, stack_t *stackb);
+int stack_transfer(stack_t *dest, stack_t *src);
+int stack_pool_stats(stack_t *stack, node_pool_stats_t *dest);
 
 #endif
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include <string.h>
 #include <stdio.h>
 
+// Enough sorted keys to overflow the stack of any recursive walk over a plain tree
+#define DEEP_KEY_COUNT 300000
+
 /**
  * @brief Print each node in order of traversal of a BST tree/subtree containing string keys
  * @param root Root node of the subtree
@@ -33,29 +36,64 @@ static int string_compare (void *k1, int ks1, void *k2, int ks2)
 int main(int argc, char **argv)
 {
     bst_tree_t *tree;
+    bst_node_t *last;
+    char key[2] = { 0 };
+    char deep_key[12];
+    int i;
     
     // Create a BST using strings as keys, and string_compare as the comparison function
     tree = bst_tree_new(string_compare);
 
     // Insert some nodes
     printf("Inserting some nodes...\n");
-    // Remember to set the tree root to the first node inserted
-    tree->root = bst_tree_insert(tree, tree->root, NULL, "N", 1);
-    bst_tree_insert(tree, tree->root, NULL, "B", 1);
-    bst_tree_insert(tree, tree->root, NULL, "X", 1);
-    bst_tree_insert(tree, tree->root, NULL, "D", 1);
-    bst_tree_insert(tree, tree->root, NULL, "H", 1);
-    bst_tree_insert(tree, tree->root, NULL, "F", 1);
+    // The first node inserted becomes the tree root
+    bst_tree_insert(tree, tree->root, NULL, "N", 2);
+    bst_tree_insert(tree, tree->root, NULL, "B", 2);
+    bst_tree_insert(tree, tree->root, NULL, "X", 2);
+    bst_tree_insert(tree, tree->root, NULL, "D", 2);
+    bst_tree_insert(tree, tree->root, NULL, "H", 2);
+    bst_tree_insert(tree, tree->root, NULL, "F", 2);
 
     // Print the tree to verify the structure matches our expectations
     printf("Printing tree in traversal order:\n");
     string_bst_tree_print(tree->root);
 
     // See if the search function finds an existing key
-    printf("\nAddress of node that contains key 'H': %lx\n", (long unsigned int)bst_tree_search(tree, tree->root, "H", 1));
+    printf("\nAddress of node that contains key 'H': %lx\n", (long unsigned int)bst_tree_search(tree, tree->root, "H", 2));
 
     // What if the key doesn't exist?
-    printf("An inexistent key returns NULL? %s\n\n", (bst_tree_search(tree, tree->root, "Z", 1) == NULL) ? "Yes" : "No");
+    printf("An inexistent key returns NULL? %s\n\n", (bst_tree_search(tree, tree->root, "Z", 2) == NULL) ? "Yes" : "No");
+    bst_tree_destroy(tree);
+
+    // Create a balanced BST and feed it keys in sorted order
+    tree = bst_tree_new_balanced(string_compare);
+    printf("Inserting sorted keys into a balanced tree...\n");
+    for (key[0] = 'A'; key[0] <= 'Z'; key[0]++)
+    {
+        bst_tree_insert(tree, tree->root, NULL, key, sizeof key);
+    }
+    printf("Printing tree in traversal order:\n");
+    string_bst_tree_print(tree->root);
+
+    // 26 keys fit within 5 levels when balanced, instead of 26 when degenerated into a list
+    printf("Tree height: %d\n", tree->root->height);
+    printf("Address of node that contains key 'Q': %lx\n", (long unsigned int)bst_tree_search(tree, tree->root, "Q", 2));
+    bst_tree_destroy(tree);
+
+    // Sorted keys degenerate a plain tree into a list as deep as the number of keys
+    tree = bst_tree_new(string_compare);
+    printf("\nInserting %d sorted keys into a plain tree...\n", DEEP_KEY_COUNT);
+    last = NULL;
+    for (i = 0; i < DEEP_KEY_COUNT; i++)
+    {
+        // Inserting below the previous key avoids walking the whole list every time
+        snprintf(deep_key, sizeof deep_key, "%06d", i);
+        last = bst_tree_insert(tree, last, NULL, deep_key, sizeof deep_key);
+        if (last->right != NULL)
+            last = last->right;
+    }
+    printf("Deepest key found? %s\n", (bst_tree_search(tree, tree->root, deep_key, sizeof deep_key) == last) ? "Yes" : "No");
+    printf("An inexistent key returns NULL? %s\n", (bst_tree_search(tree, tree->root, "999999", 7) == NULL) ? "Yes" : "No");
     bst_tree_destroy(tree);
 
     return 0;
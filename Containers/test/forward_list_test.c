@@ -26,7 +26,7 @@ static void char_list_print(forward_list_t *list)
 
 int main(int argc, char **argv)
 {
-    forward_list_t *list;
+    forward_list_t *list, *other;
     
     // Create a list of chars
     list = forward_list_new();
@@ -68,6 +68,24 @@ int main(int argc, char **argv)
     forward_list_add(list, "C", 2);
     char_list_print(list);
 
+    // A single item must be removable from the back as well
+    printf("Popping the only item from the back\n");
+    forward_list_pop_back(list, NULL);
+    char_list_print(list);
+    printf("List empty? %s\n", forward_list_empty(list) ? "Yes" : "No");
+    forward_list_add(list, "C", 2);
+    char_list_print(list);
+
+    // Chain another list's nodes after the last one
+    other = forward_list_new();
+    forward_list_add(other, "X", 2);
+    forward_list_add(other, "Y", 2);
+    printf("Concatenating 'X' and 'Y'\n");
+    forward_list_concat(list, other);
+    char_list_print(list);
+    printf("List length: %zu, other list empty? %s\n", forward_list_size(list), forward_list_empty(other) ? "Yes" : "No");
+    forward_list_destroy(other);
+
     // Destroy the list
     forward_list_destroy(list);
 
@@ -0,0 +1,123 @@
+#include "hash_map.h"
+#include <string.h>
+#include <stdio.h>
+
+#define TEST_MODULE "Hash map"
+#include "test_util.h"
+
+#define ITEM_COUNT 100000
+
+/**
+ * @brief Hash function sending every key to the same slot
+ * @param key Key to hash
+ * @param key_size Size of the key in bytes
+ * @return The same hash for any key
+ */
+static uint64_t colliding_hash(void *key, int key_size)
+{
+    return 42;
+}
+
+int main(int argc, char **argv)
+{
+    hash_map_t *map;
+    char key[24];
+    size_t capacity;
+    long value;
+    long *found;
+    int i;
+
+    printf("\n--- Hash map module unit test begins ---\n\n");
+
+    printf("Creating a hash map...\n");
+    map = hash_map_new(sizeof key, sizeof value, NULL);
+    if (map == NULL)
+        fail("map creation failed");
+    if (!hash_map_empty(map) || (hash_map_size(map) != 0) || (hash_map_find(map, "missing", 8) != NULL))
+        fail("map wasn't empty upon creation");
+
+    // Enough items to grow the table many times, keys of several sizes
+    printf("Inserting some items...\n");
+    for (i = 0; i < ITEM_COUNT; i++)
+    {
+        value = i;
+        if (hash_map_insert(map, key, sprintf(key, "key%d", i), &value) != 0)
+            fail("insertion into map failed");
+    }
+    if (hash_map_size(map) != ITEM_COUNT)
+        fail("map size does not match expectations");
+    if ((hash_map_insert(map, "this key is much too long", 26, &value) != -1) || (hash_map_insert(map, key, 0, &value) != -1))
+        fail("insertion of an invalid key should fail");
+
+    printf("Looking up every item...\n");
+    for (i = 0; i < ITEM_COUNT; i++)
+    {
+        found = hash_map_find(map, key, sprintf(key, "key%d", i));
+        if ((found == NULL) || (*found != i))
+            fail("lookup returned the wrong value");
+    }
+    // A key is told apart from its prefixes
+    if (hash_map_find(map, "key1", 3) != NULL)
+        fail("lookup found a key of a different size");
+
+    // Inserting an existing key replaces its value
+    value = -1;
+    if ((hash_map_insert(map, "key7", 4, &value) != 1) || (*(long *)hash_map_find(map, "key7", 4) != -1) || (hash_map_size(map) != ITEM_COUNT))
+        fail("insertion of an existing key did not replace its value");
+
+    // Erase every other item, then check both halves
+    printf("Erasing half of the items...\n");
+    for (i = 0; i < ITEM_COUNT; i += 2)
+    {
+        if (hash_map_erase(map, key, sprintf(key, "key%d", i)) != 0)
+            fail("erasing an item failed");
+    }
+    if ((hash_map_erase(map, "key0", 4) != -1) || (hash_map_size(map) != ITEM_COUNT / 2))
+        fail("erasing a missing item should fail");
+    for (i = 0; i < ITEM_COUNT; i++)
+    {
+        found = hash_map_find(map, key, sprintf(key, "key%d", i));
+        if ((i % 2 == 0) != (found == NULL))
+            fail("erased and remaining items do not match expectations");
+    }
+
+    // Churn through deleted slots, the table must not keep growing
+    printf("Cycling items through the map...\n");
+    hash_map_destroy(map);
+    map = hash_map_new(sizeof key, sizeof value, NULL);
+    if ((hash_map_reserve(map, 1000) != 0) || (map->capacity < 1000))
+        fail("reservation failed");
+    capacity = map->capacity;
+    for (i = 0; i < ITEM_COUNT; i++)
+    {
+        value = i;
+        hash_map_insert(map, key, sprintf(key, "cycle%d", i), &value);
+        if ((i >= 500) && (hash_map_erase(map, key, sprintf(key, "cycle%d", i - 500)) != 0))
+            fail("erasing a cycled item failed");
+    }
+    if ((hash_map_size(map) != 500) || (*(long *)hash_map_find(map, key, sprintf(key, "cycle%d", ITEM_COUNT - 1)) != ITEM_COUNT - 1))
+        fail("cycled map contents do not match expectations");
+    if (map->capacity != capacity)
+        fail("churn made the table grow");
+    hash_map_clear(map);
+    if (!hash_map_empty(map) || (hash_map_find(map, key, sprintf(key, "cycle%d", ITEM_COUNT - 1)) != NULL))
+        fail("map wasn't empty after clearing it");
+    hash_map_destroy(map);
+
+    // Colliding keys must all be probed past, across groups
+    printf("Inserting colliding keys...\n");
+    map = hash_map_new(sizeof i, 0, colliding_hash);
+    for (i = 0; i < 100; i++)
+        hash_map_insert(map, &i, sizeof i, NULL);
+    for (i = 0; i < 100; i += 3)
+        hash_map_erase(map, &i, sizeof i);
+    for (i = 0; i < 100; i++)
+    {
+        if ((hash_map_find(map, &i, sizeof i) == NULL) != (i % 3 == 0))
+            fail("colliding keys do not match expectations");
+    }
+    hash_map_destroy(map);
+
+    printf("\n--- Hash map module unit test ends. Test result: SUCCESS! ---\n");
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "heap.h"
+#include <string.h>
+#include <stdio.h>
+
+#define TEST_MODULE "Heap"
+#include "test_util.h"
+
+/**
+ * @brief Perform integer comparison on data
+ * @param data1 First data
+ * @param data1_size First data's length
+ * @param data2 Second data
+ * @param data2_size Second data's length
+ * @return 0 if data are equal, >0 if data1 > data2, <0 if data2 > data1
+ */
+static int int_compare(void *data1, int data1_size, void *data2, int data2_size)
+{
+    int a = *(int *)data1;
+    int b = *(int *)data2;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Perform inverse integer comparison on data
+ * @param data1 First data
+ * @param data1_size First data's length
+ * @param data2 Second data
+ * @param data2_size Second data's length
+ * @return 0 if data are equal, <0 if data1 > data2, >0 if data2 > data1
+ */
+static int inverse_int_compare(void *data1, int data1_size, void *data2, int data2_size)
+{
+    return -int_compare(data1, data1_size, data2, data2_size);
+}
+
+int main(int argc, char **argv)
+{
+    heap_t *heap;
+    int value;
+    int previous;
+    int i;
+
+    printf("\n--- Heap module unit test begins ---\n\n");
+
+    printf("Creating a heap...\n");
+    heap = heap_new(int_compare);
+    if (heap == NULL)
+        fail("heap creation failed");
+    if (!heap_empty(heap) || (heap_size(heap) != 0) || (heap_front(heap) != NULL) || (heap_back(heap) != NULL))
+        fail("heap wasn't empty upon creation");
+
+    // Push enough items to grow the node array several times
+    printf("Pushing some items...\n");
+    for (i = 0; i < 1000; i++)
+    {
+        value = (i * 7919) % 1000;
+        if (heap_push(heap, &value, sizeof value) != 0)
+            fail("push to heap failed");
+    }
+    if (heap_size(heap) != 1000)
+        fail("heap size does not match expectations");
+    if ((*(int *)heap_front(heap)->data != 0) || (*(int *)heap_back(heap)->data != 999))
+        fail("heap front/back do not match expectations");
+
+    // Items must come out in priority order
+    printf("Popping half of the items...\n");
+    previous = -1;
+    for (i = 0; i < 500; i++)
+    {
+        heap_peek(heap, &value);
+        heap_pop(heap, &value);
+        if (value < previous)
+            fail("heap popped items out of order");
+        previous = value;
+    }
+
+    // The lowest priority item can be popped as well
+    printf("Popping from the back...\n");
+    heap_pop_back(heap, &value);
+    if ((value != 999) || (*(int *)heap_back(heap)->data != 998) || (heap_size(heap) != 499))
+        fail("heap popped the wrong item from the back");
+
+    // Reverse the priority scheme and check the heap is rebuilt accordingly
+    printf("Rebuilding with inverse priorities...\n");
+    heap_rebuild(heap, inverse_int_compare);
+    previous = 1000;
+    while (!heap_empty(heap))
+    {
+        heap_pop(heap, &value);
+        if ((value > previous) || (value < 500))
+            fail("rebuilt heap popped items out of order");
+        previous = value;
+    }
+    if (heap_peek(heap, &value) == 0)
+        fail("peek on an empty heap should fail");
+
+    heap_destroy(heap);
+
+    printf("\n--- Heap module unit test ends. Test result: SUCCESS! ---\n");
+    return 0;
+}
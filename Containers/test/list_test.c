@@ -26,12 +26,12 @@ static void char_list_print(list_t *list)
 
 int main(int argc, char **argv)
 {
-    list_t *list;
+    list_t *list, *other, *pooled;
     
     // Create a list of chars
     list = list_new();
-    printf("List empty? %s\n", forward_list_empty(list) ? "Yes" : "No");
-    printf("List length: %zu\n", forward_list_size(list));
+    printf("List empty? %s\n", list_empty(list) ? "Yes" : "No");
+    printf("List length: %zu\n", list_size(list));
 
     // Insert some nodes
     printf("Inserting some nodes...\n");
@@ -68,6 +68,42 @@ int main(int argc, char **argv)
     list_add(list, "C", 2);
     char_list_print(list);
 
+    // Build nodes in place and read them back without copying
+    printf("Emplacing 'E' at the front and 'Z' at the back\n");
+    memcpy(list_emplace_front(list, 2), "E", 2);
+    memcpy(list_emplace_back(list, 2), "Z", 2);
+    char_list_print(list);
+    printf("Front: %s, back: %s\n", (char *)list_front_ptr(list), (char *)list_back_ptr(list));
+
+    // Move nodes between lists without copying their data
+    other = list_new();
+    list_add(other, "X", 2);
+    list_add(other, "Y", 2);
+    printf("Splicing 'X' and 'Y' before the second node\n");
+    list_splice(list, list->head->next, other);
+    char_list_print(list);
+    printf("Splitting the list after its third node\n");
+    list_split_at(list, 3, other);
+    char_list_print(list);
+    char_list_print(other);
+    printf("Concatenating both halves back\n");
+    list_concat(list, other);
+    char_list_print(list);
+    printf("List length: %zu, other list empty? %s\n", list_size(list), list_empty(other) ? "Yes" : "No");
+    list_destroy(other);
+
+    // Pooled lists relink nodes only with lists sharing their pool
+    other = list_new_pooled(2, 0);
+    list_add(other, "P", 2);
+    printf("Splicing 'P' from a pooled list into a plain one fails? %s\n", (list_splice(list, list->head, other) != 0) ? "Yes" : "No");
+    pooled = list_new_shared(other);
+    list_add(pooled, "Q", 2);
+    printf("Splicing 'P' into a list sharing its pool\n");
+    list_splice(pooled, NULL, other);
+    char_list_print(pooled);
+    list_destroy(other);
+    list_destroy(pooled);
+
     // Destroy the list
     list_destroy(list);
 
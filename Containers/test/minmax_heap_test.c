@@ -0,0 +1,145 @@
+#include "minmax_heap.h"
+#include <string.h>
+#include <stdio.h>
+
+#define TEST_MODULE "Min-max heap"
+#include "test_util.h"
+
+/**
+ * @brief Perform integer comparison on data
+ * @param data1 First data
+ * @param data1_size First data's length
+ * @param data2 Second data
+ * @param data2_size Second data's length
+ * @return 0 if data are equal, >0 if data1 > data2, <0 if data2 > data1
+ */
+static int int_compare(void *data1, int data1_size, void *data2, int data2_size)
+{
+    int a = *(int *)data1;
+    int b = *(int *)data2;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Perform inverse integer comparison on data
+ * @param data1 First data
+ * @param data1_size First data's length
+ * @param data2 Second data
+ * @param data2_size Second data's length
+ * @return 0 if data are equal, <0 if data1 > data2, >0 if data2 > data1
+ */
+static int inverse_int_compare(void *data1, int data1_size, void *data2, int data2_size)
+{
+    return -int_compare(data1, data1_size, data2, data2_size);
+}
+
+int main(int argc, char **argv)
+{
+    minmax_heap_t *heap;
+    int counts[1000];
+    int low, high;
+    int value;
+    int i;
+
+    printf("\n--- Min-max heap module unit test begins ---\n\n");
+
+    printf("Creating a min-max heap...\n");
+    heap = minmax_heap_new(int_compare);
+    if (heap == NULL)
+        fail("heap creation failed");
+    if (!minmax_heap_empty(heap) || (minmax_heap_size(heap) != 0) || (minmax_heap_front(heap) != NULL) || (minmax_heap_back(heap) != NULL))
+        fail("heap wasn't empty upon creation");
+    if ((minmax_heap_peek_front(heap, &value) == 0) || (minmax_heap_peek_back(heap, &value) == 0))
+        fail("peek on an empty heap should fail");
+
+    // Push enough items, duplicates included, to grow the node array several times
+    printf("Pushing some items...\n");
+    memset(counts, 0, sizeof counts);
+    for (i = 0; i < 2000; i++)
+    {
+        value = (i * 7919) % 1000;
+        counts[value]++;
+        if (minmax_heap_push(heap, &value, sizeof value) != 0)
+            fail("push to heap failed");
+    }
+    if (minmax_heap_size(heap) != 2000)
+        fail("heap size does not match expectations");
+    if ((*(int *)minmax_heap_front(heap)->data != 0) || (*(int *)minmax_heap_back(heap)->data != 999))
+        fail("heap front/back do not match expectations");
+
+    // Both ends must come out in priority order, alternating between them
+    printf("Popping from both ends...\n");
+    low = 0;
+    high = 999;
+    for (i = 0; i < 1000; i++)
+    {
+        while (counts[low] == 0)
+            low++;
+        while (counts[high] == 0)
+            high--;
+        if (i % 3 == 0)
+        {
+            minmax_heap_peek_back(heap, &value);
+            minmax_heap_pop_back(heap, &value);
+            if (value != high)
+                fail("heap popped the back out of order");
+        }
+        else
+        {
+            minmax_heap_peek_front(heap, &value);
+            minmax_heap_pop_front(heap, &value);
+            if (value != low)
+                fail("heap popped the front out of order");
+        }
+        counts[value]--;
+    }
+
+    // Reverse the priority scheme and check both ends swap places
+    printf("Rebuilding with inverse priorities...\n");
+    minmax_heap_rebuild(heap, inverse_int_compare);
+    while (counts[low] == 0)
+        low++;
+    while (counts[high] == 0)
+        high--;
+    if ((*(int *)minmax_heap_front(heap)->data != high) || (*(int *)minmax_heap_back(heap)->data != low))
+        fail("rebuilt heap front/back do not match expectations");
+    while (!minmax_heap_empty(heap))
+    {
+        minmax_heap_pop_back(heap, &value);
+        while (counts[low] == 0)
+            low++;
+        if (value != low)
+            fail("rebuilt heap popped items out of order");
+        counts[value]--;
+    }
+
+    // Interleaved pushes and pops must keep both ends valid
+    printf("Interleaving pushes and pops...\n");
+    for (i = 0; i < 5000; i++)
+    {
+        value = (i * 104729) % 997;
+        counts[value]++;
+        minmax_heap_push(heap, &value, sizeof value);
+        if (i % 4 == 3)
+        {
+            minmax_heap_pop_front(heap, &value);
+            counts[value]--;
+            minmax_heap_pop_back(heap, &value);
+            counts[value]--;
+        }
+        for (low = 0; counts[low] == 0; low++)
+            ;
+        for (high = 999; counts[high] == 0; high--)
+            ;
+        if ((*(int *)minmax_heap_back(heap)->data != low) || (*(int *)minmax_heap_front(heap)->data != high))
+            fail("heap ends do not match expectations after interleaved operations");
+    }
+
+    minmax_heap_clear(heap);
+    if (!minmax_heap_empty(heap))
+        fail("heap wasn't empty after clearing it");
+    minmax_heap_destroy(heap);
+
+    printf("\n--- Min-max heap module unit test ends. Test result: SUCCESS! ---\n");
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include "mpmc_queue.h"
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <stdio.h>
+
+#define TEST_MODULE "MPMC queue"
+#include "test_util.h"
+
+#define PRODUCER_COUNT 4
+#define CONSUMER_COUNT 4
+#define ITEMS_PER_PRODUCER 200000
+#define BATCH_SIZE 16
+
+typedef struct item
+{
+    int producer;
+    int sequence;
+} item_t;
+
+static mpmc_queue_t *shared_queue;
+static atomic_int consumed;
+static int received[PRODUCER_COUNT][ITEMS_PER_PRODUCER];
+static int order_error;
+
+/**
+ * @brief Producer thread, pushes its items one at a time or in batches
+ * @param arg Producer identifier
+ * @return NULL
+ */
+static void *producer(void *arg)
+{
+    int id = (int)(long)arg;
+    item_t batch[BATCH_SIZE];
+    size_t pushed;
+    int i, n;
+
+    for (i = 0; i < ITEMS_PER_PRODUCER;)
+    {
+        if (id % 2 == 0)
+        {
+            // Blocking single pushes
+            batch[0] = (item_t){ id, i++ };
+            mpmc_queue_push(shared_queue, &batch[0]);
+        }
+        else
+        {
+            // Batched pushes, retrying the part that didn't fit
+            for (n = 0; (n < BATCH_SIZE) && (i + n < ITEMS_PER_PRODUCER); n++)
+                batch[n] = (item_t){ id, i + n };
+            pushed = 0;
+            while ((pushed += mpmc_queue_try_push_n(shared_queue, batch + pushed, n - pushed)) < (size_t)n)
+                sched_yield();
+            i += n;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Consumer thread, pops batches until every item has been received
+ * @param arg Unused
+ * @return NULL
+ */
+static void *consumer(void *arg)
+{
+    item_t batch[BATCH_SIZE];
+    int last[PRODUCER_COUNT];
+    size_t popped, i;
+
+    for (i = 0; i < PRODUCER_COUNT; i++)
+        last[i] = -1;
+    while (atomic_load(&consumed) < PRODUCER_COUNT * ITEMS_PER_PRODUCER)
+    {
+        popped = mpmc_queue_try_pop_n(shared_queue, batch, BATCH_SIZE);
+        if (popped == 0)
+            sched_yield();
+        for (i = 0; i < popped; i++)
+        {
+            // Items from one producer must reach any given consumer in order
+            if (batch[i].sequence <= last[batch[i].producer])
+                order_error = 1;
+            last[batch[i].producer] = batch[i].sequence;
+            received[batch[i].producer][batch[i].sequence]++;
+        }
+        atomic_fetch_add(&consumed, (int)popped);
+    }
+
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    mpmc_queue_t *queue;
+    pthread_t producers[PRODUCER_COUNT];
+    pthread_t consumers[CONSUMER_COUNT];
+    int batch[8];
+    int value;
+    long i;
+    int j;
+
+    printf("\n--- MPMC queue module unit test begins ---\n\n");
+
+    printf("Creating an MPMC queue...\n");
+    queue = mpmc_queue_new(sizeof value, 3);
+    if (queue == NULL)
+        fail("queue creation failed");
+    if ((mpmc_queue_capacity(queue) != 4) || !mpmc_queue_empty(queue) || (mpmc_queue_size(queue) != 0))
+        fail("queue wasn't empty with a power-of-two capacity upon creation");
+    if (mpmc_queue_try_pop(queue, &value) == 0)
+        fail("pop on an empty queue should fail");
+
+    // Fill the queue beyond its capacity, then drain it in order
+    printf("Filling the queue...\n");
+    for (value = 0; value < 3; value++)
+    {
+        if (mpmc_queue_try_push(queue, &value) != 0)
+            fail("push to a non-full queue failed");
+    }
+    for (j = 0; j < 8; j++)
+        batch[j] = 3 + j;
+    if ((mpmc_queue_try_push_n(queue, batch, 8) != 1) || (mpmc_queue_try_push(queue, &value) == 0))
+        fail("batch push overfilled the queue");
+    if ((mpmc_queue_size(queue) != 4) || (mpmc_queue_try_pop_n(queue, batch, 8) != 4))
+        fail("queue size does not match expectations");
+    for (j = 0; j < 4; j++)
+    {
+        if (batch[j] != j)
+            fail("batch pop contents do not match expectations");
+    }
+    value = 42;
+    mpmc_queue_push(queue, &value);
+    value = 0;
+    mpmc_queue_pop(queue, &value);
+    if ((value != 42) || !mpmc_queue_empty(queue))
+        fail("blocking push/pop do not match expectations");
+    mpmc_queue_destroy(queue);
+
+    // Every item must be received exactly once under contention
+    printf("Transferring items between several producers and consumers...\n");
+    shared_queue = mpmc_queue_new(sizeof(item_t), 256);
+    if (shared_queue == NULL)
+        fail("queue creation failed");
+    for (i = 0; i < CONSUMER_COUNT; i++)
+    {
+        if (pthread_create(&consumers[i], NULL, consumer, NULL) != 0)
+            fail("consumer thread creation failed");
+    }
+    for (i = 0; i < PRODUCER_COUNT; i++)
+    {
+        if (pthread_create(&producers[i], NULL, producer, (void *)i) != 0)
+            fail("producer thread creation failed");
+    }
+    for (i = 0; i < PRODUCER_COUNT; i++)
+        pthread_join(producers[i], NULL);
+    for (i = 0; i < CONSUMER_COUNT; i++)
+        pthread_join(consumers[i], NULL);
+    if (order_error)
+        fail("items from one producer were received out of order");
+    for (i = 0; i < PRODUCER_COUNT; i++)
+    {
+        for (j = 0; j < ITEMS_PER_PRODUCER; j++)
+        {
+            if (received[i][j] != 1)
+                fail("an item was lost or duplicated");
+        }
+    }
+    if (!mpmc_queue_empty(shared_queue))
+        fail("queue wasn't empty after the transfer");
+    mpmc_queue_destroy(shared_queue);
+
+    printf("\n--- MPMC queue module unit test ends. Test result: SUCCESS! ---\n");
+    return 0;
+}
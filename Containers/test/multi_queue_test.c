@@ -0,0 +1,139 @@
+#include "multi_queue.h"
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <stdio.h>
+
+#define TEST_MODULE "Multi queue"
+#include "test_util.h"
+
+#define THREAD_COUNT 4
+#define ITEMS_PER_THREAD 50000
+#define SEQUENTIAL_ITEMS 10000
+
+static multi_queue_t *shared_queue;
+static atomic_int consumed;
+static atomic_uchar received[THREAD_COUNT * ITEMS_PER_THREAD];
+
+/**
+ * @brief Perform integer comparison on data
+ * @param data1 First data
+ * @param data1_size First data's length
+ * @param data2 Second data
+ * @param data2_size Second data's length
+ * @return 0 if data are equal, >0 if data1 > data2, <0 if data2 > data1
+ */
+static int int_compare(void *data1, int data1_size, void *data2, int data2_size)
+{
+    int a = *(int *)data1;
+    int b = *(int *)data2;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Worker thread, pushes its own items and pops until every item has been received
+ * @param arg Thread identifier
+ * @return NULL
+ */
+static void *worker(void *arg)
+{
+    int id = (int)(long)arg;
+    int value;
+    int i;
+
+    for (i = 0; i < ITEMS_PER_THREAD; i++)
+    {
+        value = i * THREAD_COUNT + id;
+        if (multi_queue_push(shared_queue, &value, sizeof value) != 0)
+            fail("push to queue failed");
+
+        // Interleave pops with pushes so heaps are contended from both sides
+        if ((i % 2 == 1) && (multi_queue_pop(shared_queue, &value) == 0))
+        {
+            if (atomic_fetch_add(&received[value], 1) != 0)
+                fail("item popped twice");
+            atomic_fetch_add(&consumed, 1);
+        }
+    }
+
+    while (atomic_load(&consumed) < THREAD_COUNT * ITEMS_PER_THREAD)
+    {
+        if (multi_queue_pop(shared_queue, &value) != 0)
+        {
+            sched_yield();
+            continue;
+        }
+        if (atomic_fetch_add(&received[value], 1) != 0)
+            fail("item popped twice");
+        atomic_fetch_add(&consumed, 1);
+    }
+
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    pthread_t threads[THREAD_COUNT];
+    static unsigned char seen[SEQUENTIAL_ITEMS];
+    size_t rank_sum = 0;
+    int value;
+    int i;
+
+    printf("\n--- Multi queue module unit test begins ---\n\n");
+
+    printf("Creating a multi queue...\n");
+    shared_queue = multi_queue_new(int_compare, THREAD_COUNT, 2);
+    if (shared_queue == NULL)
+        fail("queue creation failed");
+    if (!multi_queue_empty(shared_queue) || (multi_queue_heaps(shared_queue) != THREAD_COUNT * 2))
+        fail("queue wasn't empty upon creation");
+    if (multi_queue_pop(shared_queue, &value) == 0)
+        fail("pop on an empty queue should fail");
+
+    // From a single thread, every item comes out once and close to priority order
+    printf("Pushing and popping items from a single thread...\n");
+    for (i = 0; i < SEQUENTIAL_ITEMS; i++)
+    {
+        value = (i * 7919) % SEQUENTIAL_ITEMS;
+        if (multi_queue_push(shared_queue, &value, sizeof value) != 0)
+            fail("push to queue failed");
+    }
+    if (multi_queue_size(shared_queue) != SEQUENTIAL_ITEMS)
+        fail("queue size does not match expectations");
+    for (i = 0; i < SEQUENTIAL_ITEMS; i++)
+    {
+        if (multi_queue_pop(shared_queue, &value) != 0)
+            fail("pop failed while the queue held items");
+        if (seen[value]++ != 0)
+            fail("item popped twice");
+        // Items were popped in order, so the rank of this one is its distance to the i-th smallest
+        rank_sum += (value > i) ? value - i : i - value;
+    }
+    if (!multi_queue_empty(shared_queue) || (multi_queue_pop(shared_queue, &value) == 0))
+        fail("queue wasn't empty after popping every item");
+    // The expected rank error is in the order of the number of heaps, leave plenty of margin
+    if (rank_sum / SEQUENTIAL_ITEMS > 10 * multi_queue_heaps(shared_queue))
+        fail("popped items are too far from priority order");
+
+    // Concurrent pushes and pops must neither lose nor duplicate items
+    printf("Pushing and popping items from %d threads...\n", THREAD_COUNT);
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        if (pthread_create(&threads[i], NULL, worker, (void *)(long)i) != 0)
+            fail("thread creation failed");
+    }
+    for (i = 0; i < THREAD_COUNT; i++)
+        pthread_join(threads[i], NULL);
+    for (i = 0; i < THREAD_COUNT * ITEMS_PER_THREAD; i++)
+    {
+        if (received[i] != 1)
+            fail("item was lost");
+    }
+    if (!multi_queue_empty(shared_queue))
+        fail("queue wasn't empty after popping every item");
+
+    multi_queue_destroy(shared_queue);
+
+    printf("\n--- Multi queue module unit test ends. Test result: SUCCESS! ---\n");
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "queue.h"
+#include <string.h>
+#include <stdio.h>
+
+#define TEST_MODULE "Node pool"
+#include "test_util.h"
+
+int main(int argc, char **argv)
+{
+    node_pool_t *pool;
+    queue_t *queue;
+    node_pool_stats_t stats;
+    void *blocks[3];
+    void *oversized;
+    size_t slab_allocs;
+    int value;
+    int i;
+
+    printf("\n--- Node pool module unit test begins ---\n\n");
+
+    // Blocks are reserved a slab at a time and recycled through the free list
+    printf("Allocating blocks from a pool...\n");
+    pool = node_pool_new(24, 2);
+    if (pool == NULL)
+        fail("pool creation failed");
+    for (i = 0; i < 3; i++)
+    {
+        blocks[i] = node_pool_alloc(pool, 24);
+        if (blocks[i] == NULL)
+            fail("block allocation failed");
+    }
+    if ((pool->stats.slab_allocs != 2) || (pool->blocks_in_use != 3))
+        fail("pool did not reserve exactly two slabs for three blocks");
+    node_pool_free(pool, blocks[2], 24);
+    if (node_pool_alloc(pool, 24) != blocks[2])
+        fail("freed block was not recycled first");
+
+    // Oversized requests bypass the slabs
+    oversized = node_pool_alloc(pool, 100);
+    if ((oversized == NULL) || (pool->stats.fallback_allocs != 1))
+        fail("oversized block was not served by malloc");
+    node_pool_free(pool, oversized, 100);
+
+    // Slabs can only be released once every block is back
+    if (node_pool_release(pool) == 0)
+        fail("slabs were released while blocks were still in use");
+    for (i = 0; i < 3; i++)
+        node_pool_free(pool, blocks[i], 24);
+    if ((node_pool_release(pool) != 0) || (pool->stats.slab_frees != 2))
+        fail("slabs were not released once the pool was idle");
+
+    // A shared pool survives until its last user destroys it
+    if ((node_pool_share(pool) != pool) || (pool->users != 2))
+        fail("sharing the pool did not register a new user");
+    node_pool_destroy(pool);
+    if ((pool->users != 1) || (node_pool_alloc(pool, 24) == NULL))
+        fail("pool was freed while it still had a user");
+    node_pool_destroy(pool);
+
+    // A pooled queue must not touch malloc in a steady push/pop cycle
+    printf("Cycling items through a pooled queue...\n");
+    queue = queue_new_pooled(sizeof value, 16);
+    if (queue == NULL)
+        fail("pooled queue creation failed");
+    for (value = 0; value < 8; value++)
+        queue_push(queue, &value, sizeof value);
+    queue_pool_stats(queue, &stats);
+    slab_allocs = stats.slab_allocs;
+    for (i = 0; i < 10000; i++)
+    {
+        queue_pop(queue, &value);
+        if (queue_push(queue, &value, sizeof value) != 0)
+            fail("push to pooled queue failed");
+    }
+    queue_pool_stats(queue, &stats);
+    if ((stats.slab_allocs != slab_allocs) || (stats.fallback_allocs != 0))
+        fail("steady state push/pop cycle reserved memory");
+    queue_peek(queue, &value);
+    if (value != 10000 % 8)
+        fail("pooled queue contents do not match expectations");
+
+    // Nodes adopting a buffer only need the links, so they still fit the pool's blocks
+    if (queue_push_owned(queue, malloc(1024), 1024) != 0)
+        fail("owned push to pooled queue failed");
+    queue_pool_stats(queue, &stats);
+    if (stats.fallback_allocs != 0)
+        fail("owned push fell back to malloc for its node");
+
+    // Clearing the queue releases its slabs
+    queue_clear(queue);
+    queue_pool_stats(queue, &stats);
+    if (stats.slab_frees != stats.slab_allocs)
+        fail("clearing the queue did not release its slabs");
+    queue_destroy(queue);
+
+    printf("\n--- Node pool module unit test ends. Test result: SUCCESS! ---\n");
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include "pairing_heap.h"
+#include <string.h>
+#include <stdio.h>
+
+#define TEST_MODULE "Pairing heap"
+#include "test_util.h"
+
+#define HANDLES 1000
+
+/**
+ * @brief Perform integer comparison on data
+ * @param data1 First data
+ * @param data1_size First data's length
+ * @param data2 Second data
+ * @param data2_size Second data's length
+ * @return 0 if data are equal, >0 if data1 > data2, <0 if data2 > data1
+ */
+static int int_compare(void *data1, int data1_size, void *data2, int data2_size)
+{
+    int a = *(int *)data1;
+    int b = *(int *)data2;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Perform inverse integer comparison on data
+ * @param data1 First data
+ * @param data1_size First data's length
+ * @param data2 Second data
+ * @param data2_size Second data's length
+ * @return 0 if data are equal, <0 if data1 > data2, >0 if data2 > data1
+ */
+static int inverse_int_compare(void *data1, int data1_size, void *data2, int data2_size)
+{
+    return -int_compare(data1, data1_size, data2, data2_size);
+}
+
+/**
+ * @brief Pop every item of a heap and check they come out in order
+ * @param heap Pointer to the heap structure
+ * @param expected Number of items the heap must contain
+ * @param sign 1 for ascending order, -1 for descending order
+ */
+static void drain(pairing_heap_t *heap, size_t expected, int sign)
+{
+    int previous = 0;
+    int value;
+    size_t count = 0;
+
+    while (!pairing_heap_empty(heap))
+    {
+        pairing_heap_pop(heap, &value);
+        if ((count > 0) && ((value - previous) * sign < 0))
+            fail("heap popped items out of order");
+        previous = value;
+        count++;
+    }
+    if (count != expected)
+        fail("heap did not contain the expected number of items");
+}
+
+int main(int argc, char **argv)
+{
+    pairing_heap_t *heap;
+    pairing_heap_t *other;
+    node_t *handles[HANDLES];
+    int value;
+    int i;
+
+    printf("\n--- Pairing heap module unit test begins ---\n\n");
+
+    printf("Creating a pairing heap...\n");
+    heap = pairing_heap_new(int_compare);
+    if (heap == NULL)
+        fail("heap creation failed");
+    if (!pairing_heap_empty(heap) || (pairing_heap_size(heap) != 0) || (pairing_heap_front(heap) != NULL) || (pairing_heap_back(heap) != NULL))
+        fail("heap wasn't empty upon creation");
+
+    // Every push hands out a handle to the new item
+    printf("Pushing some items...\n");
+    for (i = 0; i < HANDLES; i++)
+    {
+        value = (i * 7919) % HANDLES;
+        handles[i] = pairing_heap_push(heap, &value, sizeof value);
+        if ((handles[i] == NULL) || (*(int *)handles[i]->data != value))
+            fail("push to heap failed");
+    }
+    if (pairing_heap_size(heap) != HANDLES)
+        fail("heap size does not match expectations");
+    pairing_heap_peek(heap, &value);
+    if ((value != 0) || (*(int *)pairing_heap_back(heap)->data != HANDLES - 1))
+        fail("heap front/back do not match expectations");
+
+    // Pop once so the heap is no longer a flat list of children, the first item pushed was the front
+    pairing_heap_pop(heap, &value);
+    handles[0] = NULL;
+
+    // Raise and lower priorities through the handles
+    printf("Updating items through their handles...\n");
+    for (i = 0; i < HANDLES; i++)
+    {
+        if (handles[i] == NULL)
+            continue;
+        *(int *)handles[i]->data = (i % 2 == 0) ? -i : i + HANDLES;
+        pairing_heap_update(heap, handles[i]);
+    }
+    pairing_heap_peek(heap, &value);
+    if ((value != -(HANDLES - 2)) || (*(int *)pairing_heap_back(heap)->data != 2 * HANDLES - 1))
+        fail("heap front/back do not match expectations after updates");
+
+    // Erase every third item, wherever it sits in the heap
+    printf("Erasing items through their handles...\n");
+    for (i = 0; i < HANDLES; i += 3)
+    {
+        if (handles[i] == NULL)
+            continue;
+        pairing_heap_erase(heap, handles[i], &value);
+        if (value != ((i % 2 == 0) ? -i : i + HANDLES))
+            fail("erased item does not match expectations");
+        handles[i] = NULL;
+    }
+    if (pairing_heap_size(heap) != HANDLES - (HANDLES + 2) / 3)
+        fail("heap size does not match expectations after erasing items");
+
+    // Melding moves every item over without invalidating handles
+    printf("Melding two heaps...\n");
+    other = pairing_heap_new(int_compare);
+    for (i = 0; i < 100; i++)
+    {
+        value = 5000 + i;
+        pairing_heap_push(other, &value, sizeof value);
+    }
+    pairing_heap_meld(heap, other);
+    if (!pairing_heap_empty(other) || (pairing_heap_size(heap) != HANDLES - (HANDLES + 2) / 3 + 100))
+        fail("meld did not move every item");
+    *(int *)handles[1]->data = -HANDLES;
+    pairing_heap_update(heap, handles[1]);
+    if (pairing_heap_front(heap) != handles[1])
+        fail("handle was not valid after melding");
+
+    // Reverse the priority scheme and check the heap is rebuilt accordingly
+    printf("Rebuilding with inverse priorities...\n");
+    pairing_heap_rebuild(heap, inverse_int_compare);
+    if (*(int *)pairing_heap_front(heap)->data != 5099)
+        fail("rebuilt heap front does not match expectations");
+    drain(heap, HANDLES - (HANDLES + 2) / 3 + 100, -1);
+
+    // Melding heaps with different priorities pairs the source's items again under the destination's
+    for (i = 0; i < 100; i++)
+    {
+        value = i;
+        pairing_heap_push(heap, &value, sizeof value);
+        pairing_heap_push(other, &value, sizeof value);
+    }
+    pairing_heap_meld(other, heap);
+    drain(other, 200, 1);
+    if (pairing_heap_peek(heap, &value) == 0)
+        fail("peek on an empty heap should fail");
+
+    // The source keeps its own priorities for later pushes
+    for (i = 1; i <= 3; i++)
+        pairing_heap_push(heap, &i, sizeof i);
+    if ((pairing_heap_peek(heap, &value) != 0) || (value != 3))
+        fail("source heap changed priorities after melding");
+    drain(heap, 3, -1);
+
+    pairing_heap_destroy(other);
+    pairing_heap_destroy(heap);
+
+    printf("\n--- Pairing heap module unit test ends. Test result: SUCCESS! ---\n");
+    return 0;
+}
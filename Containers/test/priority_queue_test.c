@@ -86,6 +86,8 @@ static void front_back_split(node_t *source, node_t **front_ref, node_t **back_r
     slow->next = NULL;
 }
 
+static int sort_calls;
+
 /**
  * @brief Perform a sorted merge on two lists with a given comparison function for their nodes
  * @param front First of the merging lists
@@ -143,9 +145,22 @@ void merge_sort(node_t **head_ref, cmp_func_t compare)
     *head_ref = sorted_merge(front, back, compare);
 }
 
+/**
+ * @brief Sort a singly-linked list with merge sort, counting the calls
+ * @param head_ref Reference to the head of the list
+ * @param compare Comparison function used for merging lists
+ */
+static void counting_sort(node_t **head_ref, cmp_func_t compare)
+{
+    sort_calls++;
+    merge_sort(head_ref, compare);
+}
+
 int main(int argc, char **argv)
 {
     priority_queue_t *queue, *queue2;
+    node_t *handle, *handle2;
+    uint64_t deadline;
     int error = 0;
     size_t pushed_nodes = 0;
     size_t pushed_nodes2 = 0;
@@ -374,6 +389,128 @@ int main(int argc, char **argv)
     memset(test_buffer, 0, sizeof(test_buffer));
     memset(test_buffer2, 0, sizeof(test_buffer2));
 
+    // Swapping queues with the same priority scheme must not reorder anything
+    printf("Swapping contents of queues with the same priorities...\n");
+    priority_queue_destroy(queue2);
+    queue2 = priority_queue_new(string_compare, counting_sort);
+    priority_queue_push(queue2, "B", 2);
+    priority_queue_push(queue2, "Z", 2);
+    priority_queue_swap(queue, queue2);
+    priority_queue_swap(queue, queue2);
+    if (sort_calls != 0)
+    {
+        fprintf(stderr, "Error: swapping queues with the same priorities sorted them\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+
+    // Both ends of a double-ended queue must be reachable, even once it runs empty
+    printf("Popping from both ends of a min-max heap queue...\n");
+    priority_queue_destroy(queue2);
+    queue2 = priority_queue_new_minmax(string_compare);
+    priority_queue_push(queue2, "M", 2);
+    priority_queue_push(queue2, "B", 2);
+    priority_queue_push(queue2, "Y", 2);
+    priority_queue_push(queue2, "F", 2);
+    priority_queue_peek_back(queue2, test_buffer2);
+    priority_queue_pop_back(queue2, test_buffer2 + 2);
+    priority_queue_pop(queue2, test_buffer2 + 4);
+    if ((strcmp(test_buffer2, "Y") != 0) || (strcmp(test_buffer2 + 2, "Y") != 0) || (strcmp(test_buffer2 + 4, "B") != 0)
+        || (strcmp((const char *)priority_queue_front(queue2)->data, "F") != 0) || (strcmp((const char *)priority_queue_back(queue2)->data, "M") != 0))
+    {
+        fprintf(stderr, "Error: min-max heap queue ends do not match expectations\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    priority_queue_clear(queue2);
+    priority_queue_clear(queue);
+    if ((priority_queue_back(queue) != NULL) || (priority_queue_back(queue2) != NULL) || (priority_queue_peek_back(queue, test_buffer) == 0))
+    {
+        fprintf(stderr, "Error: back of an empty queue should be NULL\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    memset(test_buffer, 0, sizeof(test_buffer));
+    memset(test_buffer2, 0, sizeof(test_buffer2));
+
+    // Handles let items of a pairing heap queue be rescheduled or removed in place
+    printf("Updating and erasing items of a pairing heap queue through their handles...\n");
+    priority_queue_destroy(queue2);
+    queue2 = priority_queue_new_pairing(string_compare);
+    handle = priority_queue_push_handle(queue2, "M", 2);
+    handle2 = priority_queue_push_handle(queue2, "K", 2);
+    priority_queue_push(queue2, "T", 2);
+    ((char *)handle->data)[0] = 'A';
+    if ((priority_queue_update(queue2, handle) != 0) || (priority_queue_front(queue2) != handle)
+        || (priority_queue_erase(queue2, handle2, test_buffer2) != 0) || (strcmp(test_buffer2, "K") != 0)
+        || (priority_queue_size(queue2) != 2) || (priority_queue_push_handle(queue, "C", 2) != NULL))
+    {
+        fprintf(stderr, "Error: pairing heap queue handles do not work as expected\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+
+    // Melding pairing heap queues links them, any other combination moves items one by one
+    printf("Melding queues...\n");
+    priority_queue_push(queue, "C", 2);
+    priority_queue_push(queue, "Z", 2);
+    priority_queue_meld(queue2, queue);
+    priority_queue_destroy(queue);
+    queue = priority_queue_new_pairing(inverse_string_compare);
+    priority_queue_push(queue, "B", 2);
+    priority_queue_meld(queue2, queue);
+    if (!priority_queue_empty(queue) || (priority_queue_size(queue2) != 5) || (priority_queue_front(queue2) != handle))
+    {
+        fprintf(stderr, "Error: melded queue contents do not match expectations\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    // The emptied source keeps its own priorities
+    priority_queue_push(queue, "1", 2);
+    priority_queue_push(queue, "2", 2);
+    priority_queue_push(queue, "3", 2);
+    priority_queue_peek(queue, test_buffer2);
+    if (strcmp(test_buffer2, "3") != 0)
+    {
+        fprintf(stderr, "Error: melded source queue changed priorities\n");
+        fprintf(stderr, "Actual:\n\t%s\n", test_buffer2);
+        fprintf(stderr, "Expected:\n\t3\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    priority_queue_clear(queue);
+    while (!priority_queue_empty(queue2))
+    {
+        priority_queue_pop(queue2, test_buffer2);
+        strcat(test_buffer, test_buffer2);
+    }
+    if (strcmp(test_buffer, "ABCTZ") != 0)
+    {
+        fprintf(stderr, "Error: melded queue contents do not match expectations\n");
+        fprintf(stderr, "Actual:\n\t%s\n", test_buffer);
+        fprintf(stderr, "Expected:\n\tABCTZ\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    memset(test_buffer, 0, sizeof(test_buffer));
+    memset(test_buffer2, 0, sizeof(test_buffer2));
+
+    // Radix heap queues order items by an integer key and only accept keys that aren't in the past
+    printf("Pushing and popping deadlines through a radix heap queue...\n");
+    priority_queue_destroy(queue2);
+    queue2 = priority_queue_new_radix(0);
+    // Push 10, 7, 4 and 1, the unsigned counter stops once it wraps around
+    for (deadline = 10; deadline <= 10; deadline -= 3)
+        priority_queue_push(queue2, &deadline, sizeof deadline);
+    priority_queue_pop(queue2, &deadline);
+    if ((deadline != 1) || (priority_queue_push(queue2, &(uint64_t){ 0 }, sizeof deadline) == 0)
+        || (*(uint64_t *)priority_queue_front(queue2)->data != 4) || (*(uint64_t *)priority_queue_back(queue2)->data != 10))
+    {
+        fprintf(stderr, "Error: radix heap queue contents do not match expectations\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+
     // Destroy the queues
     printf("Cleaning up...\n");
     priority_queue_destroy(queue);
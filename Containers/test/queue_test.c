@@ -35,6 +35,10 @@ int main(int argc, char **argv)
     char peeked_value[2] = { 0 };
     char test_buffer[512] = { 0 };
     char test_buffer2[512] = { 0 };
+    int fixed_value;
+    int popped_fixed_value;
+    void *owned, *popped_owned;
+    size_t popped_size;
 
     printf("\n--- Queue module unit test begins ---\n\n");
     printf("Queue implemented as a FIFO: -> [ back | X | X | X | X | front ] ->\n\n");
@@ -252,6 +256,165 @@ int main(int argc, char **argv)
     queue_destroy(queue);
     queue_destroy(queue2);
 
+    // Create a fixed-size queue and push enough items to wrap around and grow its ring
+    printf("Creating a fixed-size queue...\n");
+    queue = queue_new_fixed(sizeof fixed_value, 4);
+    if (queue == NULL)
+    {
+        fprintf(stderr, "Error in fixed-size queue creation\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    printf("Cycling items through the fixed-size queue...\n");
+    for (fixed_value = 0; fixed_value < 40; fixed_value++)
+    {
+        error |= queue_push(queue, &fixed_value, sizeof fixed_value);
+        if (fixed_value % 3 == 0)
+            queue_pop(queue, NULL);
+    }
+    if (error || (queue_push(queue, "C", 2) == 0))
+    {
+        fprintf(stderr, "Error: fixed-size queue push should only accept items of its own size\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    // Items 0 to 13 have been popped, 14 to 39 remain in order
+    for (pushed_nodes = 14; !queue_empty(queue); pushed_nodes++)
+    {
+        queue_peek(queue, &fixed_value);
+        queue_pop(queue, &popped_fixed_value);
+        if ((fixed_value != (int)pushed_nodes) || (popped_fixed_value != fixed_value))
+        {
+            fprintf(stderr, "Error: fixed-size queue contents do not match expectations\n");
+            fprintf(stderr, "Actual:\n\t%d\n", popped_fixed_value);
+            fprintf(stderr, "Expected:\n\t%zu\n", pushed_nodes);
+            printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+            exit(1);
+        }
+    }
+    if ((pushed_nodes != 40) || (queue_size(queue) != 0) || (queue_front(queue) != NULL))
+    {
+        fprintf(stderr, "Error: fixed-size queue empty/size do not match expectations\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    queue_destroy(queue);
+
+    // Build items in place and inspect them without copying, on both kinds of queue
+    printf("Emplacing items in list-backed and fixed-size queues...\n");
+    queue = queue_new();
+    queue2 = queue_new_fixed(sizeof fixed_value, 4);
+    for (fixed_value = 0; fixed_value < 10; fixed_value++)
+    {
+        *(int *)queue_emplace(queue, sizeof fixed_value) = fixed_value;
+        *(int *)queue_emplace(queue2, sizeof fixed_value) = fixed_value;
+    }
+    if ((*(int *)queue_front_ptr(queue) != 0) || (*(int *)queue_back_ptr(queue) != 9) ||
+        (*(int *)queue_front_ptr(queue2) != 0) || (*(int *)queue_back_ptr(queue2) != 9) ||
+        (queue_emplace(queue2, 2) != NULL))
+    {
+        fprintf(stderr, "Error: emplaced queue contents do not match expectations\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    queue_clear(queue);
+    queue_clear(queue2);
+    if ((queue_front_ptr(queue) != NULL) || (queue_back_ptr(queue2) != NULL))
+    {
+        fprintf(stderr, "Error: pointer peeks on empty queues should return NULL\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    queue_destroy(queue);
+    queue_destroy(queue2);
+
+    // Adopted buffers travel through a list-backed queue without being copied
+    printf("Moving owned buffers through list-backed and fixed-size queues...\n");
+    queue = queue_new();
+    queue2 = queue_new_fixed(sizeof fixed_value, 0);
+    owned = malloc(sizeof fixed_value);
+    *(int *)owned = 7;
+    queue_push(queue, &fixed_value, sizeof fixed_value);
+    error = queue_push_owned(queue, owned, sizeof fixed_value);
+    // Inline items come back in a buffer of their own
+    popped_owned = queue_pop_owned(queue, &popped_size);
+    error |= (popped_owned == NULL) || (popped_owned == owned) || (popped_size != sizeof fixed_value);
+    free(popped_owned);
+    popped_owned = queue_pop_owned(queue, NULL);
+    error |= (popped_owned != owned) || (queue_pop_owned(queue, NULL) != NULL);
+    // Fixed-size queues copy the item and free the buffer they were handed
+    error |= queue_push_owned(queue2, popped_owned, sizeof fixed_value);
+    popped_owned = queue_pop_owned(queue2, &popped_size);
+    error |= (popped_owned == NULL) || (*(int *)popped_owned != 7) || (popped_size != sizeof fixed_value);
+    free(popped_owned);
+    // Adopted buffers still queued are freed along with the queue
+    queue_push_owned(queue, malloc(16), 16);
+    if (error)
+    {
+        fprintf(stderr, "Error: owned buffers did not move through the queues as expected\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    queue_destroy(queue);
+    queue_destroy(queue2);
+
+    // Whole queues move in bulk, relinking nodes or taking over the ring
+    printf("Transferring items between queues...\n");
+    queue = queue_new();
+    queue2 = queue_new();
+    for (fixed_value = 0; fixed_value < 10; fixed_value++)
+        queue_push((fixed_value < 4) ? queue : queue2, &fixed_value, sizeof fixed_value);
+    error = queue_transfer(queue, queue2) || !queue_empty(queue2) || (queue_size(queue) != 10);
+    for (fixed_value = 0; !queue_empty(queue); fixed_value++)
+    {
+        queue_pop(queue, &popped_fixed_value);
+        error |= (popped_fixed_value != fixed_value);
+    }
+    queue_destroy(queue2);
+    queue2 = queue_new_fixed(sizeof fixed_value, 4);
+    error |= (queue_transfer(queue, queue2) == 0);
+    queue_destroy(queue);
+    queue = queue_new_fixed(sizeof fixed_value, 4);
+    for (fixed_value = 0; fixed_value < 30; fixed_value++)
+    {
+        queue_push((fixed_value % 10 < 3) ? queue : queue2, &fixed_value, sizeof fixed_value);
+        if (fixed_value % 10 == 9)
+            error |= queue_transfer(queue, queue2);
+    }
+    error |= (queue_size(queue) != 30) || !queue_empty(queue2);
+    for (fixed_value = 0; !queue_empty(queue); fixed_value++)
+    {
+        queue_pop(queue, &popped_fixed_value);
+        // Each round of ten moved its first three items ahead of the other seven
+        error |= (popped_fixed_value / 10 != fixed_value / 10);
+    }
+    queue_destroy(queue);
+    queue_destroy(queue2);
+
+    // Pooled queues relink nodes only with queues sharing their pool
+    queue = queue_new_pooled(sizeof fixed_value, 4);
+    queue2 = queue_new_pooled(sizeof fixed_value, 4);
+    queue_push(queue2, &fixed_value, sizeof fixed_value);
+    error |= (queue_transfer(queue, queue2) == 0) || (queue_size(queue2) != 1);
+    queue_destroy(queue2);
+    queue2 = queue_new_shared(queue);
+    for (fixed_value = 0; fixed_value < 10; fixed_value++)
+        queue_push((fixed_value < 4) ? queue : queue2, &fixed_value, sizeof fixed_value);
+    error |= queue_transfer(queue, queue2) || !queue_empty(queue2) || (queue_size(queue) != 10);
+    for (fixed_value = 0; !queue_empty(queue); fixed_value++)
+    {
+        queue_pop(queue, &popped_fixed_value);
+        error |= (popped_fixed_value != fixed_value);
+    }
+    if (error)
+    {
+        fprintf(stderr, "Error: queue transfers do not match expectations\n");
+        printf("\n--- Queue module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    queue_destroy(queue);
+    queue_destroy(queue2);
+
     printf("\n--- Queue module unit test ends. Test result: SUCCESS! ---\n");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "radix_heap.h"
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+
+#define TEST_MODULE "Radix heap"
+#include "test_util.h"
+
+typedef struct event
+{
+    int id;
+    uint64_t deadline;
+} event_t;
+
+int main(int argc, char **argv)
+{
+    radix_heap_t *heap;
+    event_t event;
+    uint64_t largest = 0;
+    uint64_t now;
+    uint64_t previous;
+    int i;
+
+    printf("\n--- Radix heap module unit test begins ---\n\n");
+
+    printf("Creating a radix heap...\n");
+    heap = radix_heap_new(offsetof(event_t, deadline));
+    if (heap == NULL)
+        fail("heap creation failed");
+    if (!radix_heap_empty(heap) || (radix_heap_size(heap) != 0) || (radix_heap_front(heap) != NULL) || (radix_heap_back(heap) != NULL))
+        fail("heap wasn't empty upon creation");
+
+    // Keys spread over the whole 64-bit range land in many buckets
+    printf("Pushing some items...\n");
+    for (i = 0; i < 1000; i++)
+    {
+        event.id = i;
+        event.deadline = ((uint64_t)((i * 7919) % 1000) << (i % 50)) + 5;
+        if (event.deadline > largest)
+            largest = event.deadline;
+        if (radix_heap_push(heap, &event, sizeof event) != 0)
+            fail("push to heap failed");
+    }
+    if (radix_heap_push(heap, &event, sizeof event.id) == 0)
+        fail("push of an item too small to hold a key should fail");
+    if (radix_heap_size(heap) != 1000)
+        fail("heap size does not match expectations");
+    if (((event_t *)radix_heap_front(heap)->data)->deadline != 5)
+        fail("heap front does not match expectations");
+
+    // Peeking must not restrict the keys that can be pushed
+    event.deadline = 5;
+    if (radix_heap_push(heap, &event, sizeof event) != 0)
+        fail("push of a key between the last popped key and the front failed");
+    radix_heap_pop_back(heap, &event);
+    if (event.deadline != largest)
+        fail("heap popped the wrong item from the back");
+
+    // Items must come out in key order, with new keys pushed as time goes by
+    printf("Popping and pushing items in deadline order...\n");
+    previous = 0;
+    for (i = 0; i < 5000; i++)
+    {
+        radix_heap_pop(heap, &event);
+        if (event.deadline < previous)
+            fail("heap popped items out of order");
+        previous = event.deadline;
+        now = event.deadline;
+        if (i % 2 == 0)
+        {
+            event.deadline = now + (uint64_t)(i * 104729) % 100000;
+            radix_heap_push(heap, &event, sizeof event);
+        }
+        if (radix_heap_empty(heap))
+            break;
+    }
+
+    // Keys in the past are rejected
+    event.deadline = previous - 1;
+    if (radix_heap_push(heap, &event, sizeof event) == 0)
+        fail("push of a key smaller than the last popped key should fail");
+    while (!radix_heap_empty(heap))
+    {
+        radix_heap_pop(heap, &event);
+        if (event.deadline < previous)
+            fail("heap popped items out of order");
+        previous = event.deadline;
+    }
+
+    // Clearing the heap allows any key again
+    radix_heap_clear(heap);
+    event.deadline = 0;
+    if (radix_heap_push(heap, &event, sizeof event) != 0)
+        fail("push to a cleared heap failed");
+    radix_heap_destroy(heap);
+
+    printf("\n--- Radix heap module unit test ends. Test result: SUCCESS! ---\n");
+    return 0;
+}
@@ -0,0 +1,200 @@
+#include "sort.h"
+#include <string.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define TEST_MODULE "Sort"
+#include "test_util.h"
+
+#define LARGE_ITEM_COUNT 200000
+
+typedef enum pattern
+{
+    ASCENDING,
+    DESCENDING,
+    EQUAL,
+    SAWTOOTH,
+    FEW_KEYS,
+    SHUFFLED
+} pattern_t;
+
+typedef struct record
+{
+    int key;
+    int sequence;
+} record_t;
+
+/**
+ * @brief Compare records by key only
+ * @param data1 First record
+ * @param data1_size First record's length
+ * @param data2 Second record
+ * @param data2_size Second record's length
+ * @return 0 if keys are equal, >0 if data1 > data2, <0 if data2 > data1
+ */
+static int record_compare(void *data1, int data1_size, void *data2, int data2_size)
+{
+    int a = ((record_t *)data1)->key;
+    int b = ((record_t *)data2)->key;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Compare records by key only, greater keys first
+ * @param data1 First record
+ * @param data1_size First record's length
+ * @param data2 Second record
+ * @param data2_size Second record's length
+ * @return 0 if keys are equal, <0 if data1 > data2, >0 if data2 > data1
+ */
+static int inverse_record_compare(void *data1, int data1_size, void *data2, int data2_size)
+{
+    return -record_compare(data1, data1_size, data2, data2_size);
+}
+
+/**
+ * @brief Check that a list is sorted by key, with equal keys in insertion order
+ * @param head Head of the list
+ * @param count Expected number of items
+ * @param compare Comparison function the list was sorted with
+ */
+static void check_sorted(node_t *head, size_t count, cmp_func_t compare)
+{
+    record_t *previous = NULL;
+    record_t *current;
+    size_t n = 0;
+
+    for (; head != NULL; head = head->next, n++)
+    {
+        current = head->data;
+        if ((previous != NULL) && ((compare(previous, sizeof *previous, current, sizeof *current) > 0) ||
+                                   ((previous->key == current->key) && (previous->sequence > current->sequence))))
+            fail("list is not sorted, or equal items were reordered");
+        previous = current;
+    }
+    if (n != count)
+        fail("items were lost while sorting");
+}
+
+/**
+ * @brief Generate the key of an item following an input pattern
+ * @param pattern Input pattern
+ * @param i Position of the item
+ * @param count Number of items
+ * @return Key of the item
+ */
+static int pattern_key(pattern_t pattern, size_t i, size_t count)
+{
+    switch (pattern)
+    {
+    case ASCENDING:
+        return (int)i;
+    case DESCENDING:
+        return (int)(count - i);
+    case EQUAL:
+        return 7;
+    case SAWTOOTH:
+        // Alternating ascending and descending runs of 100 items
+        return (int)(i % 100) * (((i / 100) % 2) ? -1 : 1);
+    case FEW_KEYS:
+        return (int)((i * 7919) % 13);
+    default:
+        return (int)((i * 2654435761u) % count);
+    }
+}
+
+/**
+ * @brief Sort a sorted list's contents built from an input pattern
+ * @param count Number of items
+ * @param pattern Input pattern
+ * @param compare Comparison function
+ * @param sort Sorting function
+ */
+static void run(size_t count, pattern_t pattern, cmp_func_t compare, sort_func_t sort)
+{
+    sorted_list_t *list;
+    record_t *records;
+    size_t i;
+
+    records = malloc(count * sizeof *records);
+    list = sorted_list_new(compare, sort);
+    if ((records == NULL) || (list == NULL))
+        fail("allocation failed");
+    for (i = 0; i < count; i++)
+        records[i] = (record_t){ pattern_key(pattern, i, count), (int)i };
+    if (sorted_list_insert_n(list, records, sizeof *records, count) != 0)
+        fail("bulk insertion failed");
+    check_sorted(list->head, count, compare);
+    if ((count > 0) && (list->tail->next != NULL))
+        fail("tail was not rebuilt after sorting");
+    sorted_list_destroy(list);
+    free(records);
+}
+
+int main(int argc, char **argv)
+{
+    node_t *head = NULL;
+    size_t count;
+
+    printf("\n--- Sort module unit test begins ---\n\n");
+
+    // Degenerate lists are left alone
+    natural_merge_sort(NULL, record_compare);
+    natural_merge_sort(&head, record_compare);
+    if (head != NULL)
+        fail("sorting an empty list modified it");
+
+    printf("Sorting short lists...\n");
+    for (count = 1; count < 40; count++)
+    {
+        run(count, SHUFFLED, record_compare, natural_merge_sort);
+        run(count, FEW_KEYS, record_compare, natural_merge_sort);
+    }
+
+    // Long lists would overflow the stack of a recursive merge sort
+    printf("Sorting long lists of several patterns...\n");
+    run(LARGE_ITEM_COUNT, ASCENDING, record_compare, natural_merge_sort);
+    run(LARGE_ITEM_COUNT, DESCENDING, record_compare, natural_merge_sort);
+    run(LARGE_ITEM_COUNT, EQUAL, record_compare, natural_merge_sort);
+    run(LARGE_ITEM_COUNT, SAWTOOTH, record_compare, natural_merge_sort);
+    run(LARGE_ITEM_COUNT, FEW_KEYS, record_compare, natural_merge_sort);
+    run(LARGE_ITEM_COUNT, SHUFFLED, record_compare, natural_merge_sort);
+
+    // Radix sorting replaces comparisons once the key is declared, in either direction
+    printf("Radix sorting by a declared key...\n");
+    if ((radix_sort_register(record_compare, offsetof(record_t, key), sizeof(int), 1, 0) != 0) ||
+        (radix_sort_register(inverse_record_compare, offsetof(record_t, key), sizeof(int), 1, 1) != 0) ||
+        (radix_sort_register(record_compare, 0, 3, 0, 0) == 0))
+        fail("key declaration failed");
+    for (count = 1; count < 40; count++)
+    {
+        run(count, SHUFFLED, record_compare, radix_sort);
+        run(count, FEW_KEYS, inverse_record_compare, radix_sort);
+    }
+    run(LARGE_ITEM_COUNT, SAWTOOTH, record_compare, radix_sort);
+    run(LARGE_ITEM_COUNT, SHUFFLED, record_compare, radix_sort);
+    run(LARGE_ITEM_COUNT, SAWTOOTH, inverse_record_compare, radix_sort);
+    run(LARGE_ITEM_COUNT, EQUAL, inverse_record_compare, radix_sort);
+
+    // Without a declared key, radix sorting falls back to merging
+    radix_sort_unregister(inverse_record_compare);
+    run(LARGE_ITEM_COUNT, SHUFFLED, inverse_record_compare, radix_sort);
+
+    // Parallel sorting must match the sequential result, for even and odd segment counts
+    printf("Sorting long lists on several threads...\n");
+    parallel_sort_set_threads(4);
+    if (parallel_sort_get_threads() != 4)
+        fail("thread count was not set");
+    run(LARGE_ITEM_COUNT, SHUFFLED, record_compare, parallel_merge_sort);
+    run(LARGE_ITEM_COUNT, FEW_KEYS, record_compare, parallel_merge_sort);
+    parallel_sort_set_threads(3);
+    run(LARGE_ITEM_COUNT, SAWTOOTH, record_compare, parallel_merge_sort);
+    run(LARGE_ITEM_COUNT + 1, FEW_KEYS, record_compare, parallel_merge_sort);
+    run(100, SHUFFLED, record_compare, parallel_merge_sort);
+    parallel_sort_set_threads(0);
+    if (parallel_sort_get_threads() < 1)
+        fail("default thread count is not positive");
+
+    printf("\n--- Sort module unit test ends. Test result: SUCCESS! ---\n");
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "sorted_list.h"
+#include <stdint.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -132,6 +133,9 @@ void merge_sort(node_t **head_ref, cmp_func_t compare)
 int main(int argc, char **argv)
 {
     sorted_list_t *list;
+    node_t *iterator;
+    char run[][2] = { "M", "A", "Z", "E" };
+    int aligned;
     
     // Create a sorted list of strings, using merge sort as the sorting algorithm
     list = sorted_list_new(string_compare, merge_sort);
@@ -172,6 +176,12 @@ int main(int argc, char **argv)
     sorted_list_pop_back(list, NULL);
     char_list_print(list);
 
+    // Insert a whole run at once
+    printf("Inserting 'M', 'A', 'Z' and 'E' in one go\n");
+    sorted_list_insert_n(list, run, sizeof run[0], sizeof run / sizeof run[0]);
+    char_list_print(list);
+    printf("List length: %zu\n", sorted_list_size(list));
+
     // Clear list
     sorted_list_clear(list);
 
@@ -183,5 +193,36 @@ int main(int argc, char **argv)
     // Destroy the list
     sorted_list_destroy(list);
 
+    // Create a skip list backed sorted list of strings
+    printf("\nCreating a skip list...\n");
+    list = sorted_list_new_skip(string_compare, merge_sort);
+    sorted_list_insert_n(list, run, sizeof run[0], sizeof run / sizeof run[0]);
+    sorted_list_insert(list, "B", 2);
+    sorted_list_insert(list, "X", 2);
+    char_list_print(list);
+    printf("List length: %zu\n", sorted_list_size(list));
+
+    // Look up some nodes
+    printf("Found 'M'? %s\n", (sorted_list_find(list, "M", 2) != NULL) ? "Yes" : "No");
+    printf("Found 'N'? %s\n", (sorted_list_find(list, "N", 2) != NULL) ? "Yes" : "No");
+    printf("Lower bound of 'N': %s\n", (const char *)sorted_list_lower_bound(list, "N", 2)->data);
+
+    // Items sit past each node's tower, which must keep them aligned for any type
+    aligned = 1;
+    for (iterator = list->head; iterator != NULL; iterator = iterator->next)
+        aligned &= ((uintptr_t)iterator->data % _Alignof(max_align_t) == 0);
+    printf("Every item aligned for any type? %s\n", aligned ? "Yes" : "No");
+
+    // Erase from the middle and pop from both ends
+    printf("Erasing 'M', then popping from the front and from the back\n");
+    sorted_list_erase(list, "M", 2);
+    sorted_list_pop_front(list, NULL);
+    sorted_list_pop_back(list, NULL);
+    char_list_print(list);
+    printf("Back is: %s\n", (const char *)list->tail->data);
+
+    // Destroy the list
+    sorted_list_destroy(list);
+
     return 0;
 }
\ No newline at end of file
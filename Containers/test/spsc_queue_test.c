@@ -0,0 +1,95 @@
+#include "spsc_queue.h"
+#include <pthread.h>
+#include <string.h>
+#include <stdio.h>
+
+#define TEST_MODULE "SPSC queue"
+#include "test_util.h"
+
+#define TRANSFER_COUNT 1000000
+#define BATCH_SIZE 32
+
+/**
+ * @brief Producer thread, pushes consecutive integers and spins while the queue is full
+ * @param arg Pointer to the queue structure
+ * @return NULL
+ */
+static void *producer(void *arg)
+{
+    spsc_queue_t *queue = arg;
+    int value;
+
+    for (value = 0; value < TRANSFER_COUNT; value++)
+    {
+        while (spsc_queue_push(queue, &value) != 0)
+            ;
+    }
+
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    spsc_queue_t *queue;
+    pthread_t thread;
+    int batch[BATCH_SIZE];
+    int expected;
+    int value;
+    size_t popped;
+    size_t i;
+
+    printf("\n--- SPSC queue module unit test begins ---\n\n");
+
+    printf("Creating an SPSC queue...\n");
+    queue = spsc_queue_new(sizeof value, 5);
+    if (queue == NULL)
+        fail("queue creation failed");
+    if ((spsc_queue_capacity(queue) != 8) || !spsc_queue_empty(queue) || (spsc_queue_size(queue) != 0))
+        fail("queue wasn't empty with a power-of-two capacity upon creation");
+    if (spsc_queue_pop(queue, &value) == 0)
+        fail("pop on an empty queue should fail");
+
+    // Fill the queue, then wrap around its end with a batch pop
+    printf("Filling the queue...\n");
+    for (value = 0; value < 8; value++)
+    {
+        if (spsc_queue_push(queue, &value) != 0)
+            fail("push to a non-full queue failed");
+    }
+    if (spsc_queue_push(queue, &value) == 0)
+        fail("push to a full queue should fail");
+    if ((spsc_queue_pop_n(queue, batch, 6) != 6) || (batch[0] != 0) || (batch[5] != 5))
+        fail("batch pop contents do not match expectations");
+    for (value = 8; value < 12; value++)
+        spsc_queue_push(queue, &value);
+    if ((spsc_queue_pop_n(queue, batch, BATCH_SIZE) != 6) || (batch[0] != 6) || (batch[5] != 11))
+        fail("wrapped batch pop contents do not match expectations");
+    if (!spsc_queue_empty(queue))
+        fail("queue wasn't empty after popping everything");
+    spsc_queue_destroy(queue);
+
+    // Items must cross threads exactly once and in order
+    printf("Transferring items between two threads...\n");
+    queue = spsc_queue_new(sizeof value, 1024);
+    if (queue == NULL)
+        fail("queue creation failed");
+    if (pthread_create(&thread, NULL, producer, queue) != 0)
+        fail("producer thread creation failed");
+    expected = 0;
+    while (expected < TRANSFER_COUNT)
+    {
+        popped = spsc_queue_pop_n(queue, batch, BATCH_SIZE);
+        for (i = 0; i < popped; i++)
+        {
+            if (batch[i] != expected++)
+                fail("items crossed threads out of order");
+        }
+    }
+    pthread_join(thread, NULL);
+    if (!spsc_queue_empty(queue))
+        fail("queue wasn't empty after the transfer");
+    spsc_queue_destroy(queue);
+
+    printf("\n--- SPSC queue module unit test ends. Test result: SUCCESS! ---\n");
+    return 0;
+}
@@ -35,6 +35,10 @@ int main(int argc, char **argv)
     char peeked_value[2] = { 0 };
     char test_buffer[512] = { 0 };
     char test_buffer2[512] = { 0 };
+    int fixed_value;
+    int popped_fixed_value;
+    void *owned, *popped_owned;
+    size_t popped_size;
 
     printf("\n--- Stack module unit test begins ---\n\n");
     printf("Stack implemented as a LIFO: <-> [ top | X | X | X | X | bottom ]\n\n");
@@ -252,6 +256,139 @@ int main(int argc, char **argv)
     stack_destroy(stack);
     stack_destroy(stack2);
 
+    // Create a fixed-size stack and push enough items to grow its buffer several times
+    printf("Creating a fixed-size stack...\n");
+    stack = stack_new_fixed(sizeof fixed_value, 0);
+    if ((stack == NULL) || (stack_reserve(stack, 64) != 0) || (stack->capacity != 64))
+    {
+        fprintf(stderr, "Error in fixed-size stack creation\n");
+        printf("\n--- Stack module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    stack_set_shrink_on_pop(stack, 1);
+    printf("Pushing items onto the fixed-size stack...\n");
+    for (fixed_value = 0; fixed_value < 1000; fixed_value++)
+    {
+        error |= stack_push(stack, &fixed_value, sizeof fixed_value);
+    }
+    if (error || (stack_size(stack) != 1000) || (*(int *)stack_top_ptr(stack) != 999) || (*(int *)stack_bottom_ptr(stack) != 0))
+    {
+        fprintf(stderr, "Error: fixed-size stack contents do not match expectations\n");
+        printf("\n--- Stack module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    printf("Popping items from the fixed-size stack...\n");
+    while (!stack_empty(stack))
+    {
+        fixed_value--;
+        stack_pop(stack, &popped_fixed_value);
+        if (popped_fixed_value != fixed_value)
+        {
+            fprintf(stderr, "Error: fixed-size stack popped data doesn't match expectations\n");
+            fprintf(stderr, "Actual:\n\t%d\n", popped_fixed_value);
+            fprintf(stderr, "Expected:\n\t%d\n", fixed_value);
+            printf("\n--- Stack module unit test ends. Test result: FAILURE! ---\n");
+            exit(1);
+        }
+    }
+    // Shrinking on pop must have handed the grown buffer back, down to the reserved capacity
+    if ((stack->capacity != 64) || (stack_top_ptr(stack) != NULL) || (stack_top(stack) != NULL))
+    {
+        fprintf(stderr, "Error: fixed-size stack did not shrink while being emptied\n");
+        printf("\n--- Stack module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    stack_destroy(stack);
+
+    // Build items in place on both kinds of stack
+    printf("Emplacing items onto list-backed and fixed-size stacks...\n");
+    stack = stack_new();
+    stack2 = stack_new_fixed(sizeof fixed_value, 0);
+    for (fixed_value = 0; fixed_value < 100; fixed_value++)
+    {
+        *(int *)stack_emplace(stack, sizeof fixed_value) = fixed_value;
+        *(int *)stack_emplace(stack2, sizeof fixed_value) = fixed_value;
+    }
+    if ((*(int *)stack_top_ptr(stack) != 99) || (*(int *)stack_top_ptr(stack2) != 99) ||
+        (stack_size(stack) != 100) || (stack_emplace(stack2, 2) != NULL))
+    {
+        fprintf(stderr, "Error: emplaced stack contents do not match expectations\n");
+        printf("\n--- Stack module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    stack_destroy(stack);
+    stack_destroy(stack2);
+
+    // Adopted buffers come back off a list-backed stack as the very same buffers
+    printf("Moving owned buffers through list-backed and fixed-size stacks...\n");
+    stack = stack_new();
+    stack2 = stack_new_fixed(sizeof fixed_value, 0);
+    owned = malloc(sizeof fixed_value);
+    *(int *)owned = 7;
+    error = stack_push_owned(stack, owned, sizeof fixed_value);
+    popped_owned = stack_pop_owned(stack, &popped_size);
+    error |= (popped_owned != owned) || (popped_size != sizeof fixed_value) || (stack_pop_owned(stack, NULL) != NULL);
+    error |= stack_push_owned(stack2, popped_owned, sizeof fixed_value);
+    popped_owned = stack_pop_owned(stack2, NULL);
+    error |= (popped_owned == NULL) || (*(int *)popped_owned != 7);
+    free(popped_owned);
+    if (error)
+    {
+        fprintf(stderr, "Error: owned buffers did not move through the stacks as expected\n");
+        printf("\n--- Stack module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    stack_destroy(stack);
+    stack_destroy(stack2);
+
+    // Whole stacks move in bulk, relinking nodes or copying a single block
+    printf("Transferring items between stacks...\n");
+    stack = stack_new();
+    stack2 = stack_new();
+    for (fixed_value = 0; fixed_value < 10; fixed_value++)
+        stack_push((fixed_value < 4) ? stack : stack2, &fixed_value, sizeof fixed_value);
+    error = stack_transfer(stack, stack2) || !stack_empty(stack2) || (stack_size(stack) != 10);
+    for (fixed_value = 9; !stack_empty(stack); fixed_value--)
+    {
+        stack_pop(stack, &popped_fixed_value);
+        error |= (popped_fixed_value != fixed_value);
+    }
+    stack_destroy(stack);
+    stack_destroy(stack2);
+    stack = stack_new_fixed(sizeof fixed_value, 0);
+    stack2 = stack_new_fixed(sizeof fixed_value, 0);
+    for (fixed_value = 0; fixed_value < 100; fixed_value++)
+        stack_push((fixed_value < 40) ? stack : stack2, &fixed_value, sizeof fixed_value);
+    error |= stack_transfer(stack, stack2) || !stack_empty(stack2) || (stack_size(stack) != 100);
+    error |= stack_transfer(stack2, stack) || !stack_empty(stack) || (*(int *)stack_top_ptr(stack2) != 99);
+    for (fixed_value = 99; !stack_empty(stack2); fixed_value--)
+    {
+        stack_pop(stack2, &popped_fixed_value);
+        error |= (popped_fixed_value != fixed_value);
+    }
+    stack_destroy(stack);
+    stack_destroy(stack2);
+
+    // Pooled stacks relink nodes only with stacks sharing their pool
+    stack = stack_new_pooled(sizeof fixed_value, 4);
+    stack2 = stack_new_shared(stack);
+    for (fixed_value = 0; fixed_value < 10; fixed_value++)
+        stack_push((fixed_value < 4) ? stack : stack2, &fixed_value, sizeof fixed_value);
+    error |= stack_transfer(stack, stack2) || !stack_empty(stack2) || (stack_size(stack) != 10);
+    for (fixed_value = 9; !stack_empty(stack); fixed_value--)
+    {
+        stack_pop(stack, &popped_fixed_value);
+        error |= (popped_fixed_value != fixed_value);
+    }
+    if (error)
+    {
+        fprintf(stderr, "Error: stack transfers do not match expectations\n");
+        printf("\n--- Stack module unit test ends. Test result: FAILURE! ---\n");
+        exit(1);
+    }
+    stack_destroy(stack);
+    stack_destroy(stack2);
+
     printf("\n--- Stack module unit test ends. Test result: SUCCESS! ---\n");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef _TEST_UTIL_H
+#define _TEST_UTIL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Each test defines TEST_MODULE as the name printed in its result banner before including this header
+#ifndef TEST_MODULE
+#error "TEST_MODULE must be defined before including test_util.h"
+#endif
+
+/**
+ * @brief Report a failed check and abort the test
+ * @param message Description of the failure
+ */
+static void fail(const char *message)
+{
+    fprintf(stderr, "Error: %s\n", message);
+    printf("\n--- " TEST_MODULE " module unit test ends. Test result: FAILURE! ---\n");
+    exit(1);
+}
+
+#endif
@@ -4,16 +4,16 @@
 #include <fcntl.h>
 #include "fsm.h"
 #include "task.h"
+#include "spsc_queue.h"
 
 /******************* Constants *******************/
 
 #define PRICE 50					//Coffe price
-#define FLAG_BUTTON 0x01			//Flag indicating that the init button has been pressed
-#define FLAG_ENABLE 0x02			//Flag indicating that the coffee service has been enabled
-#define FLAG_RETURN 0x04			//Flag indicating that cash return is pending
 #define T1 20000000					//Activation period of task 1 (cash handler)
 #define T2 50000000					//Activation period of task 2 (user interface)
 #define T3 100000000				//Activation period of task 3 (coffee service)
+#define EVENT_QUEUE_SIZE 64			//Capacity of every inter-task event queue
+#define INPUT_BATCH 8				//Maximum number of events drained at once
 
 /******************* FSMs states *******************/
 
@@ -29,21 +29,83 @@ enum cash_state {					//Cash handling states
 	CASH_ADQUIRED,					//Minimum credit has been entered
 };
 
+enum cash_event {					//Events sent from the coffee service to the cash handler
+	CASH_EVENT_SERVED,				//A coffee has been paid for
+	CASH_EVENT_FINISHED,			//Coffee service finished, change must be returned
+};
+
+enum cofm_event {					//Events sent from the cash handler to the coffee service
+	COFM_EVENT_ENABLE,				//Enough credit has been entered
+	COFM_EVENT_DISABLE,				//Credit has been returned
+};
+
 /******************* Global variables *******************/
 
-static int flags = 0;					//Status flags register
+// Every queue has exactly one producer and one consumer thread, so no locks are needed
+static spsc_queue_t *input_to_cash;		//User inputs for the cash handler
+static spsc_queue_t *input_to_cofm;		//User inputs for the coffee service
+static spsc_queue_t *cash_to_cofm;		//Service enabling events
+static spsc_queue_t *cofm_to_cash;		//Service progress events
+
+// Cash handler state, only touched by task 1
 static int credit = 0;					//Available credit
-pthread_mutex_t lock_flags;				//Mutex that controls access to the shared variable 'flags'
-pthread_mutex_t lock_credit;				//Mutex that controls access to the shared variable 'credit'
+static int return_requests = 0;			//Cash returns pending, one per return press or finished service
+
+// Coffee service state, only touched by task 3
+static int enabled = 0;					//Coffee service has been enabled
+static int button_presses = 0;			//Init button presses made since the service was enabled
 
+/******************* Event handling *******************/
+
+static void cash_poll (void){			//Apply every event received by the cash handler since its last activation
+	int events[INPUT_BATCH];
+	size_t n, i;
+
+	while((n = spsc_queue_pop_n(input_to_cash, events, INPUT_BATCH)) > 0){
+		for(i = 0; i < n; i++){
+			if(events[i] > 1){				//Integers greater that 1 symbolize credit entry
+				credit += events[i];
+			}else if(events[i] == 0){		//A 'zero' symbolizes pressing the return button
+				return_requests++;
+			}
+		}
+	}
+	while((n = spsc_queue_pop_n(cofm_to_cash, events, INPUT_BATCH)) > 0){
+		for(i = 0; i < n; i++){
+			if(events[i] == CASH_EVENT_SERVED){		//Coffee price is deduced from the available credit
+				credit -= PRICE;
+			}else{									//Change is returned, if there's any
+				return_requests++;
+			}
+		}
+	}
+}
+
+static void cofm_poll (void){			//Apply every event received by the coffee service since its last activation
+	int events[INPUT_BATCH];
+	size_t n, i;
+
+	while((n = spsc_queue_pop_n(input_to_cofm, events, INPUT_BATCH)) > 0){
+		for(i = 0; i < n; i++){
+			if((events[i] == 1) && enabled) button_presses++;	//A 'one' symbolizes pressing the init button, ignored while disabled
+		}
+	}
+	while((n = spsc_queue_pop_n(cash_to_cofm, events, INPUT_BATCH)) > 0){
+		for(i = 0; i < n; i++){
+			enabled = (events[i] == COFM_EVENT_ENABLE);
+			button_presses = 0;				//Only presses made after enabling start a service
+		}
+	}
+}
+
+static void send (spsc_queue_t* queue, int event){	//Post an event, the queues are sized so they never fill up in practice
+	if(spsc_queue_push(queue, &event) != 0) printf("Event queue full, event %d dropped\n", event);
+}
 
 /******************* FSMs guard functions *******************/
 
 static int button_pressed (fsm_t* this){			//Guard function that checks if coffee service must begin
-	pthread_mutex_lock(&lock_flags);
-	int pressed = ((flags&FLAG_ENABLE)*(flags&FLAG_BUTTON));	//which must happen if the button is pressed while service is enabled
-	pthread_mutex_unlock(&lock_flags);
-	return pressed;
+	return enabled && (button_presses > 0);					//which must happen if the button is pressed while service is enabled
 }
 
 static int next (fsm_t* this){			//Guard function that simulates a timed triggering
@@ -51,49 +113,31 @@ static int next (fsm_t* this){			//Guard function that simulates a timed trigger
 }
 
 static int price_reached (fsm_t* this){	//Guard function that checks if coffee service must be enabled
-	int reached = 0;
-	pthread_mutex_lock(&lock_credit);
-	pthread_mutex_lock(&lock_flags);
-	if(credit >= PRICE){				//which must happen if enough credit has been entered
-		flags |= FLAG_ENABLE;
-		reached = 1;
-	} 
-	pthread_mutex_unlock(&lock_credit);
-	pthread_mutex_unlock(&lock_flags);
-	return reached;					
+	return credit >= PRICE;				//which must happen if enough credit has been entered
 }
 
 static int return_pressed (fsm_t* this){		//Guard function that checks if cash must be returned
-	pthread_mutex_lock(&lock_flags);
-	int pressed = (flags & FLAG_RETURN);
-	pthread_mutex_unlock(&lock_flags);
-	return pressed;
+	return return_requests > 0;
 }
 
 /******************* FSMs output functions *******************/
 
 static void notify (fsm_t* this){			//Output functions that enables the coffee service and notifies the user
+	send(cash_to_cofm, COFM_EVENT_ENABLE);
 	printf("\nCoffee service is enabled\n\n");
 }
 
 static void give_change (fsm_t* this){			//Output function that triggers change giving
-	pthread_mutex_lock(&lock_flags);
-	pthread_mutex_lock(&lock_credit);
-	flags = 0;					//When change giving is forced by the user, available credit is nuled 
+	return_requests--;				//When change giving is forced by the user, available credit is nuled 
 	printf("Giving %d pennies\n\n", credit);	//and coffe service is disabled to avoid free coffee service.
 	credit = 0;
-	pthread_mutex_unlock(&lock_flags);
-	pthread_mutex_unlock(&lock_credit);
+	send(cash_to_cofm, COFM_EVENT_DISABLE);
 }
 
 static void cup (fsm_t* this){			//Output function of the first coffee service state transition
-	pthread_mutex_lock(&lock_flags);
-	pthread_mutex_lock(&lock_credit);
-	credit -= PRICE;					//Coffee price is deduced from the available credit,
-	flags &= ~(FLAG_BUTTON);			//Both flags indicating button pressed and service enabled are cleared
-	flags &= ~(FLAG_ENABLE);
-	pthread_mutex_unlock(&lock_flags);
-	pthread_mutex_unlock(&lock_credit);
+	send(cofm_to_cash, CASH_EVENT_SERVED);	//Coffee price is deduced from the available credit,
+	button_presses = 0;					//Both button presses and service enabled are cleared
+	enabled = 0;
 	printf("LED switches off.\n");			//LED is switched off to indicate that the machine is busy serving
 	printf("Dropping cup.\n\n");			//and the cup is dropped
 }
@@ -107,11 +151,9 @@ static void milk (fsm_t* this){				//Output function of the third coffee service
 }
 
 static void finish (fsm_t* this){			//Output function of the last coffee service state transition
-	pthread_mutex_lock(&lock_flags);
 	printf("Coffee is ready.\n");			//Coffee is ready
 	printf("LED switches on.\n\n");			//LED is switched on to indicate that the machine is ready to serve another coffee
-	flags |= FLAG_RETURN;					//Change is returned, if there's any
-	pthread_mutex_unlock(&lock_flags);
+	send(cofm_to_cash, CASH_EVENT_FINISHED);	//Change is returned, if there's any
 }
 
 // Explicit FSM description for coffee service behaviour
@@ -147,6 +189,7 @@ static void * fireCash(){			//Thread init function for cash handling
 	t_fill.tv_sec = 0;
         while(1){
 		clock_gettime(CLOCK_MONOTONIC, &t_before);
+		cash_poll();
 		fsm_fire(cash_fsm);
 		clock_gettime(CLOCK_MONOTONIC, &t_after);
 		difNanos = t_after.tv_nsec - t_before.tv_nsec;
@@ -181,22 +224,9 @@ static void * userEntries(){			//Thread init function for user interface managem
 		clock_gettime(CLOCK_MONOTONIC, &t_before);
 
 		if(scanf("%d",&input)==1){
-       		 	pthread_mutex_lock(&lock_flags);
-   	        	flags &= ~(FLAG_RETURN);              //By default, give_change flag is off 
-   	        	flags &= ~(FLAG_BUTTON);              //By default, button_pressed flag is off
-   	        	if(input>1){                          //Integers greater that 1 symbolize credit entry
-   	        		pthread_mutex_lock(&lock_credit);
-   	                credit += input;
-   	                pthread_mutex_unlock(&lock_credit);
-   	        	}else if(input==0){                   //A 'zero' symbolizes pressing the return button
-   	                flags |= FLAG_RETURN;
-   	        	}else if(input==1){                   //A 'one' symbolizes pressing the init button
-   	                flags |= FLAG_BUTTON;
-   	        	}else{
-					pthread_mutex_unlock(&lock_flags);
-					pthread_exit(NULL);
-				}
-   	        	pthread_mutex_unlock(&lock_flags);
+			if(input < 0) pthread_exit(NULL);	//A negative number ends the program
+			send(input_to_cash, input);			//Every input is delivered to both tasks,
+			send(input_to_cofm, input);			//which decode it on their own
 		}
 		clock_gettime(CLOCK_MONOTONIC, &t_after);
 		difNanos = t_after.tv_nsec - t_before.tv_nsec;
@@ -228,6 +258,7 @@ static void * fireCofm(){			//Thread init function for coffee service management
 	t_fill.tv_sec = 0;
         while(1){
 		clock_gettime(CLOCK_MONOTONIC, &t_before);
+		cofm_poll();
 		fsm_fire(cofm_fsm);
 		clock_gettime(CLOCK_MONOTONIC, &t_after);
 		difNanos = t_after.tv_nsec - t_before.tv_nsec;
@@ -248,8 +279,14 @@ static void * fireCofm(){			//Thread init function for coffee service management
 
 int main () {
 
-	mutex_init(&lock_flags, 0);		//Mutex initialization
-	mutex_init(&lock_credit, 0);	//using priority inheritance
+	input_to_cash = spsc_queue_new(sizeof(int), EVENT_QUEUE_SIZE);	//Event queues initialization
+	input_to_cofm = spsc_queue_new(sizeof(int), EVENT_QUEUE_SIZE);
+	cash_to_cofm = spsc_queue_new(sizeof(int), EVENT_QUEUE_SIZE);
+	cofm_to_cash = spsc_queue_new(sizeof(int), EVENT_QUEUE_SIZE);
+	if(!input_to_cash || !input_to_cofm || !cash_to_cofm || !cofm_to_cash){
+		printf("Error creating event queues\n");
+		return 1;
+	}
 
 	printf("Enter the minimum credit and press the button to start the service\n");
 